@@ -53,6 +53,11 @@ func reset():
 		end
 	""").invoke(_output.tab_size)
 	
+	if LuaState.get_lua_runtime() == "luajit":
+		# `jit_aborts()` prints where traces of code run in the REPL were aborted
+		_lua.start_jit_trace_diagnostics()
+		_lua.globals.jit_aborts = _print_jit_aborts
+	
 	_history.clear()
 	_current_history = 0
 	clear()
@@ -110,6 +115,14 @@ func _printn(msg: String):
 	_print("\n")
 
 
+func _print_jit_aborts():
+	var aborts: Dictionary = _lua.get_jit_trace_aborts()
+	for location in aborts:
+		var reasons: Dictionary = aborts[location]
+		for reason in reasons:
+			_printn("%s: %s (%d)" % [location, reason, reasons[reason]])
+
+
 func _print_error(msg: String):
 	var color: Color = EditorInterface.get_editor_settings().get_setting("text_editor/theme/highlighting/brace_mismatch_color")
 	self._output.append_text("[color=%s]%s[/color]\n" % [color.to_html(), msg.replace("[", "[lb]")])
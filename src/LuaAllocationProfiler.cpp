@@ -0,0 +1,203 @@
+/**
+ * Copyright (C) 2026 Gil Barbosa Reis.
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the “Software”), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ * of the Software, and to permit persons to whom the Software is furnished to do
+ * so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#include "LuaAllocationProfiler.hpp"
+
+#include "utils/LuaHookDispatcher.hpp"
+
+#include <cstring>
+
+namespace luagdextension {
+
+// Hook owner shared by all allocation profilers, so that only one of them profiles each LuaState
+static const char ALLOCATION_PROFILER_HOOK = 0;
+
+LuaAllocationProfiler::~LuaAllocationProfiler() {
+	stop();
+}
+
+void LuaAllocationProfiler::start(LuaState *lua_state, int sample_bytes, int instruction_interval) {
+#ifdef LUAJIT
+	ERR_FAIL_MSG("Allocation profiling is not supported in LuaJIT, which uses its builtin allocator");
+#else
+	ERR_FAIL_COND_MSG(lua_state == nullptr, "LuaState cannot be null");
+	ERR_FAIL_COND_MSG(sample_bytes <= 0, "Sample bytes must be positive");
+	ERR_FAIL_COND_MSG(instruction_interval <= 0, "Instruction interval must be positive");
+
+	stop();
+	lua_State *L = lua_state->get_lua_state();
+	LuaHookDispatcher *dispatcher = LuaHookDispatcher::get(L);
+	ERR_FAIL_NULL(dispatcher);
+	ERR_FAIL_COND_MSG(dispatcher->has(&ALLOCATION_PROFILER_HOOK), "LuaState is already being profiled by another LuaAllocationProfiler");
+
+	this->lua_state = Ref<LuaState>(lua_state);
+	this->sample_bytes = sample_bytes;
+	bytes_since_sample = 0;
+	lua_state->set_allocation_profiler(this);
+
+	// Allocations are attributed to source lines from a hook, where it's safe to inspect the stack
+	dispatcher->add(&ALLOCATION_PROFILER_HOOK, hook, this, LUA_MASKCOUNT, instruction_interval);
+#endif
+}
+
+void LuaAllocationProfiler::stop() {
+	if (lua_state.is_null()) {
+		return;
+	}
+
+	lua_State *L = lua_state->get_lua_state();
+	attribute_pending_samples(L);
+	lua_state->set_allocation_profiler(nullptr);
+	if (LuaHookDispatcher *dispatcher = LuaHookDispatcher::get(L)) {
+		dispatcher->remove(&ALLOCATION_PROFILER_HOOK);
+	}
+	lua_state.unref();
+}
+
+void LuaAllocationProfiler::clear() {
+	sites.clear();
+	site_ids.clear();
+	samples.clear();
+	pending_samples.clear();
+	bytes_since_sample = 0;
+}
+
+bool LuaAllocationProfiler::is_running() const {
+	return lua_state.is_valid();
+}
+
+Dictionary LuaAllocationProfiler::get_snapshot() const {
+	Dictionary snapshot;
+	for (const Site& site : sites) {
+		Dictionary site_info;
+		site_info["live_bytes"] = site.live_bytes;
+		site_info["allocated_bytes"] = site.allocated_bytes;
+		site_info["allocation_count"] = (int64_t) Math::round(site.allocation_count);
+		snapshot[site.name] = site_info;
+	}
+	return snapshot;
+}
+
+Dictionary LuaAllocationProfiler::diff_snapshots(const Dictionary& before, const Dictionary& after) {
+	static const char *keys[] = { "live_bytes", "allocated_bytes", "allocation_count" };
+
+	Dictionary diff;
+	Array sites = after.keys();
+	sites.append_array(before.keys());
+	for (int i = 0; i < sites.size(); i++) {
+		const Variant& site = sites[i];
+		if (diff.has(site)) {
+			continue;
+		}
+		Dictionary site_before = before.get(site, Dictionary());
+		Dictionary site_after = after.get(site, Dictionary());
+		Dictionary site_diff;
+		bool changed = false;
+		for (const char *key : keys) {
+			int64_t delta = (int64_t) site_after.get(key, 0) - (int64_t) site_before.get(key, 0);
+			site_diff[key] = delta;
+			changed = changed || delta != 0;
+		}
+		if (changed) {
+			diff[site] = site_diff;
+		}
+	}
+	return diff;
+}
+
+void LuaAllocationProfiler::record_reallocation(void *old_ptr, void *new_ptr, size_t new_size) {
+	// Reallocations are handled as a free followed by an allocation
+	if (old_ptr) {
+		if (const Sample *sample = samples.getptr(old_ptr)) {
+			if (sample->site >= 0) {
+				sites[sample->site].live_bytes -= sample->weight;
+			}
+			samples.erase(old_ptr);
+		}
+	}
+
+	if (new_ptr && new_size > 0) {
+		// Sample one allocation every `sample_bytes` bytes, weighted by the bytes it represents
+		bytes_since_sample += new_size;
+		if (bytes_since_sample >= sample_bytes) {
+			uint64_t weight = bytes_since_sample - bytes_since_sample % sample_bytes;
+			bytes_since_sample %= sample_bytes;
+			samples.insert(new_ptr, { -1, weight, new_size });
+			pending_samples.push_back(new_ptr);
+		}
+	}
+}
+
+void LuaAllocationProfiler::attribute_pending_samples(lua_State *L) {
+	if (pending_samples.is_empty()) {
+		return;
+	}
+
+	int site_id = get_site_id(L);
+	Site& site = sites[site_id];
+	for (void *ptr : pending_samples) {
+		Sample *sample = samples.getptr(ptr);
+		if (sample && sample->site < 0) {
+			sample->site = site_id;
+			site.live_bytes += sample->weight;
+			site.allocated_bytes += sample->weight;
+			site.allocation_count += (double) sample->weight / sample->size;
+		}
+	}
+	pending_samples.clear();
+}
+
+int LuaAllocationProfiler::get_site_id(lua_State *L) {
+	// Find the innermost Lua function, since C functions have no source lines
+	String name = "[unknown]";
+	lua_Debug ar;
+	for (int level = 0; lua_getstack(L, level, &ar); level++) {
+		lua_getinfo(L, "Sl", &ar);
+		if (strcmp(ar.what, "C") != 0) {
+			name = String::utf8(ar.short_src) + ":" + itos(ar.currentline);
+			break;
+		}
+		name = "[C]";
+	}
+
+	if (const int *site_id = site_ids.getptr(name)) {
+		return *site_id;
+	}
+	int site_id = sites.size();
+	sites.push_back({ name, 0, 0, 0 });
+	site_ids.insert(name, site_id);
+	return site_id;
+}
+
+void LuaAllocationProfiler::hook(lua_State *L, lua_Debug *ar, void *profiler) {
+	((LuaAllocationProfiler *) profiler)->attribute_pending_samples(L);
+}
+
+void LuaAllocationProfiler::_bind_methods() {
+	ClassDB::bind_method(D_METHOD("start", "lua_state", "sample_bytes", "instruction_interval"), &LuaAllocationProfiler::start, DEFVAL(1024), DEFVAL(100));
+	ClassDB::bind_method(D_METHOD("stop"), &LuaAllocationProfiler::stop);
+	ClassDB::bind_method(D_METHOD("clear"), &LuaAllocationProfiler::clear);
+	ClassDB::bind_method(D_METHOD("is_running"), &LuaAllocationProfiler::is_running);
+	ClassDB::bind_method(D_METHOD("get_snapshot"), &LuaAllocationProfiler::get_snapshot);
+	ClassDB::bind_static_method(get_class_static(), D_METHOD("diff_snapshots", "before", "after"), &LuaAllocationProfiler::diff_snapshots);
+}
+
+}
@@ -0,0 +1,87 @@
+/**
+ * Copyright (C) 2026 Gil Barbosa Reis.
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the “Software”), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ * of the Software, and to permit persons to whom the Software is furnished to do
+ * so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#ifndef __LUA_ALLOCATION_PROFILER_HPP__
+#define __LUA_ALLOCATION_PROFILER_HPP__
+
+#include "LuaState.hpp"
+
+#include <godot_cpp/classes/ref_counted.hpp>
+#include <godot_cpp/templates/hash_map.hpp>
+#include <godot_cpp/templates/local_vector.hpp>
+
+using namespace godot;
+
+namespace luagdextension {
+
+class LuaAllocationProfiler : public RefCounted {
+	GDCLASS(LuaAllocationProfiler, RefCounted);
+
+public:
+	virtual ~LuaAllocationProfiler();
+
+	void start(LuaState *lua_state, int sample_bytes = 1024, int instruction_interval = 100);
+	void stop();
+	void clear();
+	bool is_running() const;
+
+	Dictionary get_snapshot() const;
+	static Dictionary diff_snapshots(const Dictionary& before, const Dictionary& after);
+
+	// Called by the LuaState allocator for every successful allocation, reallocation or free
+	void record_reallocation(void *old_ptr, void *new_ptr, size_t new_size);
+
+protected:
+	static void _bind_methods();
+
+private:
+	struct Site {
+		String name;
+		int64_t live_bytes;
+		uint64_t allocated_bytes;
+		double allocation_count;
+	};
+
+	struct Sample {
+		// -1 while waiting for the hook to attribute it to a site
+		int site;
+		uint64_t weight;
+		size_t size;
+	};
+
+	Ref<LuaState> lua_state;
+	uint64_t sample_bytes = 1024;
+	uint64_t bytes_since_sample = 0;
+
+	LocalVector<Site> sites;
+	HashMap<String, int> site_ids;
+	HashMap<void *, Sample> samples;
+	LocalVector<void *> pending_samples;
+
+	void attribute_pending_samples(lua_State *L);
+	int get_site_id(lua_State *L);
+
+	static void hook(lua_State *L, lua_Debug *ar, void *profiler);
+};
+
+}
+
+#endif  // __LUA_ALLOCATION_PROFILER_HPP__
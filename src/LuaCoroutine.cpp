@@ -23,18 +23,35 @@
 
 #include "LuaError.hpp"
 #include "LuaFunction.hpp"
+#include "utils/InstructionBudget.hpp"
 #include "utils/LuaCoroutinePool.hpp"
 #include "utils/VariantArguments.hpp"
 #include "utils/convert_godot_lua.hpp"
+#include "utils/performance_monitors.hpp"
 #include "utils/string_names.hpp"
 
 #include <godot_cpp/variant/utility_functions.hpp>
 
+#include <optional>
+
 namespace luagdextension {
 
-LuaCoroutine::LuaCoroutine() : LuaThread() {}
-LuaCoroutine::LuaCoroutine(sol::thread&& thread) : LuaThread(thread) {}
-LuaCoroutine::LuaCoroutine(const sol::thread& thread) : LuaThread(thread) {}
+LuaCoroutine::LuaCoroutine() : LuaThread() {
+	alive_count.fetch_add(1, std::memory_order_relaxed);
+}
+LuaCoroutine::LuaCoroutine(sol::thread&& thread) : LuaThread(thread) {
+	alive_count.fetch_add(1, std::memory_order_relaxed);
+}
+LuaCoroutine::LuaCoroutine(const sol::thread& thread) : LuaThread(thread) {
+	alive_count.fetch_add(1, std::memory_order_relaxed);
+}
+LuaCoroutine::~LuaCoroutine() {
+	alive_count.fetch_sub(1, std::memory_order_relaxed);
+}
+
+int LuaCoroutine::get_alive_count() {
+	return alive_count.load(std::memory_order_relaxed);
+}
 
 LuaCoroutine *LuaCoroutine::create(const sol::function& function) {
 	sol::thread thread = sol::thread::create(function.lua_state());
@@ -56,9 +73,28 @@ Variant LuaCoroutine::resumev(const Array& args) {
 	return _resume(VariantArguments(args), true);
 }
 
+Variant LuaCoroutine::resume_with_budget(const Array& args, int64_t max_instructions) {
+	ERR_FAIL_COND_V_MSG(max_instructions <= 0, Variant(), "Instruction budget must be positive");
+	InstructionBudget budget(lua_object.thread_state(), max_instructions, true);
+	Variant ret = _resume(VariantArguments(args), true);
+	instruction_budget_exhausted = budget.is_exhausted();
+	return ret;
+}
+
+bool LuaCoroutine::is_instruction_budget_exhausted() const {
+	return instruction_budget_exhausted;
+}
+
 Variant LuaCoroutine::_resume(const VariantArguments& args, bool return_lua_error) {
 	ERR_FAIL_COND_V_MSG(lua_object.status() != sol::thread_status::yielded, Variant(), "Cannot resume a coroutine that is not suspended.");
+	std::optional<InstructionBudget> budget;
+	if (remaining_instruction_budget > 0) {
+		budget.emplace(lua_object.thread_state(), remaining_instruction_budget, false);
+	}
 	sol::protected_function_result function_result = _resume(lua_object.thread_state(), args);
+	if (budget) {
+		remaining_instruction_budget = function_result.status() == sol::call_status::yielded ? budget->get_remaining() : 0;
+	}
 	Variant ret = to_variant(function_result, true);
 	if (function_result.status() == sol::call_status::ok) {
 		emit_signal(string_names->completed, ret);
@@ -73,6 +109,7 @@ Variant LuaCoroutine::_resume(const VariantArguments& args, bool return_lua_erro
 }
 
 sol::protected_function_result LuaCoroutine::_resume(lua_State *L, const VariantArguments& args) {
+	lua_calls_from_godot.fetch_add(1, std::memory_order_relaxed);
 	sol::stack::push(L, args);
 
 	int nresults;
@@ -98,13 +135,34 @@ Variant LuaCoroutine::invoke_lua(const sol::protected_function& f, const Variant
 	}
 }
 
+Variant LuaCoroutine::invoke_lua_with_budget(const sol::protected_function& f, const VariantArguments& args, int64_t max_instructions) {
+	LuaCoroutinePool pool(f.lua_state());
+	sol::thread coroutine = pool.acquire(f);
+	InstructionBudget budget(coroutine.thread_state(), max_instructions, false);
+	sol::protected_function_result result = _resume(coroutine.thread_state(), args);
+	if (result.status() == sol::call_status::yielded) {
+		// The remaining budget keeps being enforced when the coroutine is resumed
+		Ref<LuaCoroutine> lua_coroutine = LuaObject::wrap_object<LuaCoroutine>(coroutine);
+		lua_coroutine->remaining_instruction_budget = budget.get_remaining();
+		return lua_coroutine;
+	}
+	else {
+		pool.release(coroutine);
+		return to_variant(result, true);
+	}
+}
+
 void LuaCoroutine::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("resumev", "arguments"), &LuaCoroutine::resumev);
 	ClassDB::bind_vararg_method(METHOD_FLAGS_DEFAULT, "resume", &LuaCoroutine::resume);
+	ClassDB::bind_method(D_METHOD("resume_with_budget", "arguments", "max_instructions"), &LuaCoroutine::resume_with_budget);
+	ClassDB::bind_method(D_METHOD("is_instruction_budget_exhausted"), &LuaCoroutine::is_instruction_budget_exhausted);
 	ClassDB::bind_static_method(get_class_static(), D_METHOD("create", "function"), sol::resolve<LuaCoroutine *(LuaFunction *)>(&LuaCoroutine::create));
 
 	ADD_SIGNAL(MethodInfo(string_names->completed, PropertyInfo(Variant::NIL, "result", PROPERTY_HINT_NONE, "", PROPERTY_USAGE_NIL_IS_VARIANT)));
 	ADD_SIGNAL(MethodInfo(string_names->failed, PropertyInfo(Variant::OBJECT, "error", PROPERTY_HINT_NONE, "", PROPERTY_USAGE_DEFAULT, LuaError::get_class_static())));
 }
 
+std::atomic<int> LuaCoroutine::alive_count = 0;
+
 }
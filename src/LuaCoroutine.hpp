@@ -24,6 +24,8 @@
 
 #include "LuaThread.hpp"
 
+#include <atomic>
+
 #include <gdextension_interface.h>
 
 using namespace godot;
@@ -39,20 +41,32 @@ public:
 	LuaCoroutine();
 	LuaCoroutine(sol::thread&& thread);
 	LuaCoroutine(const sol::thread& thread);
+	virtual ~LuaCoroutine();
+
+	static int get_alive_count();
 
 	static LuaCoroutine *create(const sol::function& function);
 	static LuaCoroutine *create(LuaFunction *function);
 
 	Variant resumev(const Array& args);
 	Variant resume(const Variant **argv, GDExtensionInt argc, GDExtensionCallError& error);
+	Variant resume_with_budget(const Array& args, int64_t max_instructions);
+	bool is_instruction_budget_exhausted() const;
 
 	static Variant invoke_lua(Ref<LuaFunction> f, const VariantArguments& args, bool return_lua_error);
 	static Variant invoke_lua(const sol::protected_function& f, const VariantArguments& args, bool return_lua_error);
+	static Variant invoke_lua_with_budget(const sol::protected_function& f, const VariantArguments& args, int64_t max_instructions);
 
 protected:
 	static void _bind_methods();
 	
 private:
+	bool instruction_budget_exhausted = false;
+	// Budget left when a function called by `LuaState.call_with_budget` yields, enforced when resumed
+	int64_t remaining_instruction_budget = 0;
+
+	static std::atomic<int> alive_count;
+
 	Variant _resume(const VariantArguments& args, bool return_lua_error);
 	static sol::protected_function_result _resume(lua_State *L, const VariantArguments& args);
 };
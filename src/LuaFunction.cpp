@@ -22,8 +22,11 @@
 #include "LuaFunction.hpp"
 
 #include "LuaDebug.hpp"
+#include "LuaError.hpp"
+#include "LuaTracer.hpp"
 #include "utils/VariantArguments.hpp"
 #include "utils/convert_godot_lua.hpp"
+#include "utils/performance_monitors.hpp"
 #include "utils/string_names.hpp"
 
 #include <godot_cpp/core/error_macros.hpp>
@@ -42,12 +45,14 @@ void LuaFunction::_bind_methods() {
 }
 
 Variant LuaFunction::invokev(const Array& args) {
+	LuaTracer::Scope trace_scope(LuaTracer::GODOT_TO_LUA, "LuaFunction::invokev");
 	return invoke_lua(lua_object, args, true);
 }
 
 Variant LuaFunction::invoke(const Variant **args, GDExtensionInt arg_count, GDExtensionCallError &error) {
 	error.error = GDEXTENSION_CALL_OK;
-	return invoke_lua(lua_object, VariantArguments(args, arg_count), true);
+	LuaTracer::Scope trace_scope(LuaTracer::GODOT_TO_LUA, "LuaFunction::invoke");
+	return invoke_lua(lua_object, args, arg_count, true);
 }
 
 Variant LuaFunction::invoke_lua(Ref<LuaFunction> f, const VariantArguments& args, bool return_lua_error) {
@@ -55,10 +60,35 @@ Variant LuaFunction::invoke_lua(Ref<LuaFunction> f, const VariantArguments& args
 }
 
 Variant LuaFunction::invoke_lua(const sol::protected_function& f, const VariantArguments& args, bool return_lua_error) {
+	lua_calls_from_godot.fetch_add(1, std::memory_order_relaxed);
 	sol::protected_function_result result = f.call(args);
 	return to_variant(result, return_lua_error);
 }
 
+Variant LuaFunction::invoke_lua(const sol::protected_function& f, const Variant **argv, int argc, bool return_lua_error) {
+	lua_State *L = f.lua_state();
+	if (!lua_checkstack(L, argc + 1)) {
+		if (return_lua_error) {
+			return memnew(LuaError(LuaError::MEMORY, "stack overflow"));
+		}
+		else {
+			ERR_PRINT("stack overflow");
+			return Variant();
+		}
+	}
+	lua_calls_from_godot.fetch_add(1, std::memory_order_relaxed);
+	int top = lua_gettop(L);
+	f.push(L);
+	for (int i = 0; i < argc; i++) {
+		lua_push(L, *argv[i]);
+	}
+	int status = lua_pcall(L, argc, LUA_MULTRET, 0);
+	int return_count = lua_gettop(L) - top;
+	// The result pops returned values from the stack when destroyed
+	sol::protected_function_result result(L, top + 1, return_count, return_count, (sol::call_status) status);
+	return to_variant(result, return_lua_error);
+}
+
 Callable LuaFunction::to_callable() const {
 	return Callable((Object *) this, string_names->invoke);
 }
@@ -44,6 +44,8 @@ public:
 
 	static Variant invoke_lua(Ref<LuaFunction> f, const VariantArguments& args, bool return_lua_error);
 	static Variant invoke_lua(const sol::protected_function& f, const VariantArguments& args, bool return_lua_error);
+	// Pushes arguments straight to the Lua stack, without copying them to an intermediate Array
+	static Variant invoke_lua(const sol::protected_function& f, const Variant **argv, int argc, bool return_lua_error);
 
 	Callable to_callable() const;
 	Ref<LuaDebug> get_debug_info() const;
@@ -36,6 +36,43 @@ uint64_t LuaObject::get_pointer_value() const {
 	return (uint64_t) get_lua_object().pointer();
 }
 
+int LuaObject::get_known_object_count() {
+	int count = 0;
+	for (KnownObjectShard& shard : known_object_shards) {
+		std::lock_guard<std::mutex> lock(shard.mutex);
+		count += shard.objects.size();
+	}
+	return count;
+}
+
+LuaObject *LuaObject::find_known_object(const void *ptr) {
+	KnownObjectShard& shard = get_known_object_shard(ptr);
+	std::lock_guard<std::mutex> lock(shard.mutex);
+	if (LuaObject **object = shard.objects.getptr(ptr)) {
+		return *object;
+	}
+	else {
+		return nullptr;
+	}
+}
+
+void LuaObject::insert_known_object(const void *ptr, LuaObject *object) {
+	KnownObjectShard& shard = get_known_object_shard(ptr);
+	std::lock_guard<std::mutex> lock(shard.mutex);
+	shard.objects.insert(ptr, object);
+}
+
+void LuaObject::erase_known_object(const void *ptr) {
+	KnownObjectShard& shard = get_known_object_shard(ptr);
+	std::lock_guard<std::mutex> lock(shard.mutex);
+	shard.objects.erase(ptr);
+}
+
+LuaObject::KnownObjectShard& LuaObject::get_known_object_shard(const void *ptr) {
+	// Lua objects are at least 8-byte aligned, so skip the low bits
+	return known_object_shards[((uintptr_t) ptr >> 3) % KNOWN_OBJECT_SHARD_COUNT];
+}
+
 void LuaObject::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("get_lua_state"), &LuaObject::get_lua_state);
 	ClassDB::bind_method(D_METHOD("get_pointer_value"), &LuaObject::get_pointer_value);
@@ -45,6 +82,6 @@ String LuaObject::_to_string() const {
 	return String("[%s:0x%x]") % Array::make(get_class(), get_pointer_value());
 }
 
-HashMap<const void *, LuaObject *> LuaObject::known_objects;
+LuaObject::KnownObjectShard LuaObject::known_object_shards[KNOWN_OBJECT_SHARD_COUNT];
 
 }
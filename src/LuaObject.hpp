@@ -24,6 +24,8 @@
 
 #include "LuaState.hpp"
 
+#include <mutex>
+
 #include <godot_cpp/classes/ref_counted.hpp>
 #include <sol/sol.hpp>
 
@@ -40,10 +42,12 @@ public:
 
 	uint64_t get_pointer_value() const;
 
+	static int get_known_object_count();
+
 	template<typename Subclass, typename ref_t>
 	static Ref<Subclass> wrap_object(const sol::basic_object<ref_t>& lua_obj) {
-		if (LuaObject **known_obj = known_objects.getptr(lua_obj.pointer())) {
-			return (Subclass *) *known_obj;
+		if (LuaObject *known_obj = find_known_object(lua_obj.pointer())) {
+			return (Subclass *) known_obj;
 		}
 		else {
 			return memnew(Subclass(lua_obj));
@@ -55,7 +59,20 @@ protected:
 
 	virtual String _to_string() const;
 
-	static HashMap<const void *, LuaObject *> known_objects;
+	// Known objects are shared by all LuaStates, which may run in different threads.
+	// The map is split in shards with their own locks to reduce contention.
+	static LuaObject *find_known_object(const void *ptr);
+	static void insert_known_object(const void *ptr, LuaObject *object);
+	static void erase_known_object(const void *ptr);
+
+private:
+	static constexpr int KNOWN_OBJECT_SHARD_COUNT = 16;
+	struct KnownObjectShard {
+		std::mutex mutex;
+		HashMap<const void *, LuaObject *> objects;
+	};
+	static KnownObjectShard known_object_shards[KNOWN_OBJECT_SHARD_COUNT];
+	static KnownObjectShard& get_known_object_shard(const void *ptr);
 };
 
 
@@ -69,19 +86,19 @@ public:
 		if (!lua_object.valid()) {
 			ERR_FAIL_MSG("FIXME: invalid reference to Lua object");
 		}
-		known_objects.insert(lua_object.pointer(), this);
+		insert_known_object(lua_object.pointer(), this);
 		lua_state = get_lua_state();
 	}
 	LuaObjectSubclass(const TReference& lua_object) : lua_object(lua_object) {
 		if (!lua_object.valid()) {
 			ERR_FAIL_MSG("FIXME: invalid reference to Lua object");
 		}
-		known_objects.insert(lua_object.pointer(), this);
+		insert_known_object(lua_object.pointer(), this);
 		lua_state = get_lua_state();
 	}
 
 	virtual ~LuaObjectSubclass() {
-		known_objects.erase(lua_object.pointer());
+		erase_known_object(lua_object.pointer());
 	}
 
 	const sol::reference& get_lua_object() const override {
@@ -0,0 +1,228 @@
+/**
+ * Copyright (C) 2026 Gil Barbosa Reis.
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the “Software”), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ * of the Software, and to permit persons to whom the Software is furnished to do
+ * so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#include "LuaSamplingProfiler.hpp"
+
+#include "utils/LuaHookDispatcher.hpp"
+
+#include <cstring>
+
+#include <godot_cpp/classes/time.hpp>
+
+namespace luagdextension {
+
+// Hook owner shared by all sampling profilers, so that only one of them profiles each LuaState
+static const char SAMPLING_PROFILER_HOOK = 0;
+
+LuaSamplingProfiler::~LuaSamplingProfiler() {
+	stop();
+}
+
+void LuaSamplingProfiler::start(LuaState *lua_state, int instruction_interval, int usec_interval) {
+	ERR_FAIL_COND_MSG(lua_state == nullptr, "LuaState cannot be null");
+	ERR_FAIL_COND_MSG(instruction_interval <= 0, "Instruction interval must be positive");
+	ERR_FAIL_COND_MSG(usec_interval < 0, "Microsecond interval cannot be negative");
+
+	stop();
+	lua_State *L = lua_state->get_lua_state();
+	LuaHookDispatcher *dispatcher = LuaHookDispatcher::get(L);
+	ERR_FAIL_NULL(dispatcher);
+	ERR_FAIL_COND_MSG(dispatcher->has(&SAMPLING_PROFILER_HOOK), "LuaState is already being profiled by another LuaSamplingProfiler");
+
+	this->lua_state = Ref<LuaState>(lua_state);
+	this->instruction_interval = instruction_interval;
+	this->usec_interval = usec_interval;
+	last_sample_usec = Time::get_singleton()->get_ticks_usec();
+	dispatcher->add(&SAMPLING_PROFILER_HOOK, hook, this, LUA_MASKCOUNT, instruction_interval);
+}
+
+void LuaSamplingProfiler::stop() {
+	if (lua_state.is_null()) {
+		return;
+	}
+
+	if (LuaHookDispatcher *dispatcher = LuaHookDispatcher::get(lua_state->get_lua_state())) {
+		dispatcher->remove(&SAMPLING_PROFILER_HOOK);
+	}
+	lua_state.unref();
+}
+
+void LuaSamplingProfiler::clear() {
+	sample_count = 0;
+	nodes.clear();
+	node_children.clear();
+	frame_ids.clear();
+	frame_labels.clear();
+}
+
+bool LuaSamplingProfiler::is_running() const {
+	return lua_state.is_valid();
+}
+
+uint64_t LuaSamplingProfiler::get_sample_count() const {
+	return sample_count;
+}
+
+String LuaSamplingProfiler::get_folded_stacks() const {
+	PackedStringArray lines;
+	for (uint32_t i = 1; i < nodes.size(); i++) {
+		if (nodes[i].self_samples > 0) {
+			lines.append(get_node_path(i) + " " + itos(nodes[i].self_samples));
+		}
+	}
+	return String("\n").join(lines);
+}
+
+Dictionary LuaSamplingProfiler::get_tree() const {
+	if (nodes.is_empty()) {
+		return Dictionary();
+	}
+
+	LocalVector<LocalVector<int>> children;
+	children.resize(nodes.size());
+	for (uint32_t i = 1; i < nodes.size(); i++) {
+		children[nodes[i].parent].push_back(i);
+	}
+	return get_node_dictionary(0, children);
+}
+
+void LuaSamplingProfiler::sample(lua_State *L) {
+	if (usec_interval > 0) {
+		uint64_t now = Time::get_singleton()->get_ticks_usec();
+		if (now - last_sample_usec < usec_interval) {
+			return;
+		}
+		last_sample_usec = now;
+	}
+
+	sampled_stack.clear();
+	lua_Debug ar;
+	for (int level = 0; lua_getstack(L, level, &ar); level++) {
+		sampled_stack.push_back(get_frame_id(L, &ar));
+	}
+
+	if (nodes.is_empty()) {
+		nodes.push_back({ -1, -1, 0, 0 });
+	}
+	int node = 0;
+	nodes[node].total_samples++;
+	for (int i = (int) sampled_stack.size() - 1; i >= 0; i--) {
+		node = get_child_node(node, sampled_stack[i]);
+		nodes[node].total_samples++;
+	}
+	nodes[node].self_samples++;
+	sample_count++;
+}
+
+int LuaSamplingProfiler::get_frame_id(lua_State *L, lua_Debug *ar) {
+	lua_getinfo(L, "fSn", ar);
+	FrameKey key = {
+		String::utf8(ar->source),
+		ar->linedefined,
+		lua_tocfunction(L, -1),
+		ar->name ? String::utf8(ar->name) : String("?"),
+	};
+	lua_pop(L, 1);
+	if (const int *frame_id = frame_ids.getptr(key)) {
+		return *frame_id;
+	}
+
+	String label = key.name;
+	if (ar->what && strcmp(ar->what, "C") == 0) {
+		label += " [C]";
+	}
+	else {
+		label += vformat(" (%s:%d)", String::utf8(ar->short_src), ar->linedefined);
+	}
+	// ';' separates frames in folded stacks
+	label = label.replace(";", ":");
+
+	int frame_id = frame_labels.size();
+	frame_labels.push_back(label);
+	frame_ids.insert(key, frame_id);
+	return frame_id;
+}
+
+int LuaSamplingProfiler::get_child_node(int parent, int frame) {
+	uint64_t key = ((uint64_t) parent << 32) | (uint32_t) frame;
+	if (const int *child = node_children.getptr(key)) {
+		return *child;
+	}
+
+	int child = nodes.size();
+	nodes.push_back({ frame, parent, 0, 0 });
+	node_children.insert(key, child);
+	return child;
+}
+
+String LuaSamplingProfiler::get_node_path(int node) const {
+	PackedStringArray frames;
+	for (; node > 0; node = nodes[node].parent) {
+		frames.append(frame_labels[nodes[node].frame]);
+	}
+	frames.reverse();
+	return String(";").join(frames);
+}
+
+Dictionary LuaSamplingProfiler::get_node_dictionary(int node, const LocalVector<LocalVector<int>>& children) const {
+	Array child_dictionaries;
+	for (int child : children[node]) {
+		child_dictionaries.append(get_node_dictionary(child, children));
+	}
+
+	Dictionary dict;
+	dict["name"] = node > 0 ? frame_labels[nodes[node].frame] : String("root");
+	dict["total_samples"] = nodes[node].total_samples;
+	dict["self_samples"] = nodes[node].self_samples;
+	dict["children"] = child_dictionaries;
+	return dict;
+}
+
+bool LuaSamplingProfiler::FrameKey::operator==(const FrameKey& other) const {
+	return line_defined == other.line_defined
+		&& cfunction == other.cfunction
+		&& source == other.source
+		&& name == other.name;
+}
+
+uint32_t LuaSamplingProfiler::FrameKey::hash(const FrameKey& key) {
+	uint32_t hash = key.source.hash();
+	hash = hash_murmur3_one_32(key.line_defined, hash);
+	hash = hash_murmur3_one_64((uint64_t) (uintptr_t) key.cfunction, hash);
+	hash = hash_murmur3_one_32(key.name.hash(), hash);
+	return hash_fmix32(hash);
+}
+
+void LuaSamplingProfiler::hook(lua_State *L, lua_Debug *ar, void *profiler) {
+	((LuaSamplingProfiler *) profiler)->sample(L);
+}
+
+void LuaSamplingProfiler::_bind_methods() {
+	ClassDB::bind_method(D_METHOD("start", "lua_state", "instruction_interval", "usec_interval"), &LuaSamplingProfiler::start, DEFVAL(1000), DEFVAL(0));
+	ClassDB::bind_method(D_METHOD("stop"), &LuaSamplingProfiler::stop);
+	ClassDB::bind_method(D_METHOD("clear"), &LuaSamplingProfiler::clear);
+	ClassDB::bind_method(D_METHOD("is_running"), &LuaSamplingProfiler::is_running);
+	ClassDB::bind_method(D_METHOD("get_sample_count"), &LuaSamplingProfiler::get_sample_count);
+	ClassDB::bind_method(D_METHOD("get_folded_stacks"), &LuaSamplingProfiler::get_folded_stacks);
+	ClassDB::bind_method(D_METHOD("get_tree"), &LuaSamplingProfiler::get_tree);
+}
+
+}
@@ -0,0 +1,96 @@
+/**
+ * Copyright (C) 2026 Gil Barbosa Reis.
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the “Software”), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ * of the Software, and to permit persons to whom the Software is furnished to do
+ * so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#ifndef __LUA_SAMPLING_PROFILER_HPP__
+#define __LUA_SAMPLING_PROFILER_HPP__
+
+#include "LuaState.hpp"
+
+#include <godot_cpp/classes/ref_counted.hpp>
+#include <godot_cpp/templates/hash_map.hpp>
+#include <godot_cpp/templates/local_vector.hpp>
+
+using namespace godot;
+
+namespace luagdextension {
+
+class LuaSamplingProfiler : public RefCounted {
+	GDCLASS(LuaSamplingProfiler, RefCounted);
+
+public:
+	virtual ~LuaSamplingProfiler();
+
+	void start(LuaState *lua_state, int instruction_interval = 1000, int usec_interval = 0);
+	void stop();
+	void clear();
+	bool is_running() const;
+
+	uint64_t get_sample_count() const;
+	String get_folded_stacks() const;
+	Dictionary get_tree() const;
+
+protected:
+	static void _bind_methods();
+
+private:
+	struct Node {
+		int frame;
+		int parent;
+		uint64_t self_samples;
+		uint64_t total_samples;
+	};
+
+	Ref<LuaState> lua_state;
+	int instruction_interval = 0;
+	uint64_t usec_interval = 0;
+	uint64_t last_sample_usec = 0;
+	uint64_t sample_count = 0;
+
+	// Call tree, where node 0 is the root
+	LocalVector<Node> nodes;
+	HashMap<uint64_t, int> node_children;
+	// Frames are identified by their source location instead of the function address,
+	// since the address of a collected closure may be reused by a different function
+	struct FrameKey {
+		String source;
+		int line_defined;
+		lua_CFunction cfunction;
+		String name;
+
+		bool operator==(const FrameKey& other) const;
+		static uint32_t hash(const FrameKey& key);
+	};
+	HashMap<FrameKey, int, FrameKey> frame_ids;
+	LocalVector<String> frame_labels;
+	LocalVector<int> sampled_stack;
+
+	void sample(lua_State *L);
+	int get_frame_id(lua_State *L, lua_Debug *ar);
+	int get_child_node(int parent, int frame);
+	String get_node_path(int node) const;
+	Dictionary get_node_dictionary(int node, const LocalVector<LocalVector<int>>& children) const;
+
+	static void hook(lua_State *L, lua_Debug *ar, void *profiler);
+};
+
+}
+
+#endif  // __LUA_SAMPLING_PROFILER_HPP__
@@ -21,18 +21,25 @@
  */
 #include "LuaState.hpp"
 
+#include "LuaAllocationProfiler.hpp"
+#include "LuaCoroutine.hpp"
 #include "LuaFunction.hpp"
 #include "LuaTable.hpp"
 #include "LuaThread.hpp"
 #include "luaopen/godot.hpp"
+#include "utils/VariantArguments.hpp"
 #include "utils/_G_metatable.hpp"
 #include "utils/convert_godot_lua.hpp"
 #include "utils/module_names.hpp"
+#include "utils/parallel_map.hpp"
+#include "utils/performance_monitors.hpp"
 
 #include <godot_cpp/core/binder_common.hpp>
 #include <godot_cpp/classes/engine.hpp>
 #include <godot_cpp/classes/os.hpp>
 #include <godot_cpp/classes/project_settings.hpp>
+#include <godot_cpp/classes/time.hpp>
+#include <godot_cpp/templates/local_vector.hpp>
 #include <luaconf.h>
 
 #ifndef LUAJIT
@@ -43,19 +50,8 @@
 
 namespace luagdextension {
 
-/// Lua memory allocation callback.
-/// Uses Godot memory functions.
-static void *lua_alloc(void *ud, void *ptr, size_t osize, size_t nsize) {
-	if (nsize == 0) {
-		if (ptr != nullptr) {
-			memfree(ptr);
-		}
-		return nullptr;
-	}
-	else {
-		return memrealloc(ptr, nsize);
-	}
-}
+// VM instructions between checks for a pending soft memory limit collection
+static constexpr int MEMORY_SOFT_LIMIT_CHECK_INSTRUCTIONS = 1000;
 
 static int lua_panic_handler(lua_State *L) {
 	return sol::default_at_panic(L);
@@ -69,23 +65,47 @@ static void lua_warn_handler(void *ud, const char *msg, int tocont) {
 #endif
 
 LuaState::LuaState()
+	: LuaState(ALLOCATOR_DEFAULT)
+{
+}
+
+LuaState::LuaState(Allocator allocator)
 #ifdef LUAJIT  // LuaJIT needs its default allocator in x64 platforms
-	: lua_state(lua_panic_handler)
+	: allocator(ALLOCATOR_DEFAULT)
+	, lua_state(lua_panic_handler)
 #else
-	: lua_state(lua_panic_handler, lua_alloc)
+	: allocator(allocator)
+	, lua_state(lua_panic_handler, lua_alloc, this)
 #endif
 {
+#ifdef LUAJIT
+	if (allocator != ALLOCATOR_DEFAULT) {
+		WARN_PRINT("Custom allocators are not supported in LuaJIT, using the default allocator.");
+	}
+#endif
 	setup_G_metatable(lua_state);
+	hook_dispatcher.attach(lua_state);
 #ifdef HAVE_LUA_WARN
 	lua_setwarnf(lua_state, lua_warn_handler, this);
 #endif
+	std::unique_lock lock(valid_states_mutex);
 	valid_states.insert(lua_state, this);
 }
 
 LuaState::~LuaState() {
+	remove_performance_monitors();
+	{
+		std::lock_guard lock(gc_scheduled_states_mutex);
+		gc_scheduled_states.erase(this);
+	}
+	std::unique_lock lock(valid_states_mutex);
 	valid_states.erase(lua_state);
 }
 
+Ref<LuaState> LuaState::create(Allocator allocator) {
+	return memnew(LuaState(allocator));
+}
+
 sol::state_view LuaState::get_lua_state() const {
 	return lua_state;
 }
@@ -168,6 +188,7 @@ void LuaState::open_libraries(BitField<Library> libraries) {
 	}
 
 	lua_state.registry().set("_GDEXTENSION_OPEN_LIBS", lua_state.registry().get_or("_GDEXTENSION_OPEN_LIBS", 0) | libraries);
+	publish_memory_used();
 }
 
 bool LuaState::are_libraries_opened(BitField<Library> libraries) const {
@@ -208,6 +229,17 @@ Variant LuaState::do_file(const String& filename, LoadMode mode, LuaTable *env)
 	return ::luagdextension::do_file(lua_state, filename, (sol::load_mode) mode, env);
 }
 
+Variant LuaState::call_with_budget(LuaFunction *function, const Array& args, int64_t max_instructions) {
+	ERR_FAIL_COND_V_MSG(function == nullptr, Variant(), "Function cannot be null");
+	ERR_FAIL_COND_V_MSG(function->get_lua_state() != this, Variant(), "Function belongs to another LuaState");
+	ERR_FAIL_COND_V_MSG(max_instructions <= 0, Variant(), "Instruction budget must be positive");
+	return LuaCoroutine::invoke_lua_with_budget(function->get_function(), VariantArguments(args), max_instructions);
+}
+
+Variant LuaState::parallel_map(const String& function_source, const Variant& packed_array, int64_t chunk_size) {
+	return ::luagdextension::parallel_map(this, function_source, packed_array, chunk_size);
+}
+
 Ref<LuaTable> LuaState::get_globals() const {
 	return LuaObject::wrap_object<LuaTable>(lua_state.globals());
 }
@@ -290,9 +322,67 @@ uint64_t LuaState::get_memory_used() const {
 	return lua_state.memory_used();
 }
 
+uint64_t LuaState::get_memory_peak() const {
+	return memory_peak;
+}
+
+void LuaState::reset_memory_peak() {
+	memory_peak = memory_in_use;
+}
+
+uint64_t LuaState::get_allocation_count() const {
+	return allocation_count;
+}
+
+uint64_t LuaState::get_failed_allocation_count() const {
+	return failed_allocation_count;
+}
+
+uint64_t LuaState::get_memory_soft_limit() const {
+	return memory_soft_limit;
+}
+
+void LuaState::set_memory_soft_limit(uint64_t limit) {
+#ifdef LUAJIT
+	WARN_PRINT_ONCE("Memory limits are not supported in LuaJIT.");
+#endif
+	memory_soft_limit = limit;
+	memory_soft_limit_reached = false;
+	memory_soft_limit_pending = false;
+	update_memory_soft_limit_hook();
+}
+
+uint64_t LuaState::get_memory_limit() const {
+	return memory_limit;
+}
+
+void LuaState::set_memory_limit(uint64_t limit) {
+#ifdef LUAJIT
+	WARN_PRINT_ONCE("Memory limits are not supported in LuaJIT.");
+#endif
+	memory_limit = limit;
+}
+
+LuaState::Allocator LuaState::get_allocator() const {
+	return allocator;
+}
+
+Dictionary LuaState::get_allocator_stats() const {
+	if (allocator == ALLOCATOR_POOL) {
+		return pool_allocator.get_stats();
+	}
+	else {
+		return Dictionary();
+	}
+}
+
 LuaState::GcMode LuaState::change_gc_mode_incremental(int pause, int step_multiplier, int step_byte_size) {
+	if (pause != 0) {
+		gc_pause = pause;
+	}
 #if LUA_VERSION_NUM >= 504
 	int previous_gc_mode = lua_gc(lua_state, LUA_GCINC, pause, step_multiplier, step_byte_size);
+	gc_mode = GC_MODE_INCREMENTAL;
 	if (previous_gc_mode == LUA_GCGEN) {
 		return GC_MODE_GENERATIONAL;
 	}
@@ -313,6 +403,7 @@ LuaState::GcMode LuaState::change_gc_mode_incremental(int pause, int step_multip
 LuaState::GcMode LuaState::change_gc_mode_generational(int minor_multiplier, int major_multiplier) {
 #if LUA_VERSION_NUM >= 504
 	int previous_gc_mode = lua_gc(lua_state, LUA_GCGEN, minor_multiplier, major_multiplier);
+	gc_mode = GC_MODE_GENERATIONAL;
 	if (previous_gc_mode == LUA_GCGEN) {
 		return GC_MODE_GENERATIONAL;
 	}
@@ -328,6 +419,133 @@ bool LuaState::supports_gc_mode(GcMode mode) const {
 	return lua_state.supports_gc_mode((sol::gc_mode) mode);
 }
 
+int64_t LuaState::step_gc_with_budget(int64_t budget_usec) {
+	ERR_FAIL_COND_V_MSG(budget_usec <= 0, 0, "GC budget must be positive, use collect_garbage for a full cycle");
+	Time *time = Time::get_singleton();
+	uint64_t start_usec = time->get_ticks_usec();
+	uint64_t memory_used = get_memory_used();
+	uint64_t allocated_kilobytes = memory_used > gc_memory_at_last_step ? (memory_used - gc_memory_at_last_step) / 1024 : 0;
+	int steps = 0;
+
+	if (gc_mode == GC_MODE_GENERATIONAL) {
+		// Each step is a whole minor collection, so run at most one per frame and only if there is new garbage
+		if (allocated_kilobytes > 0) {
+			lua_gc(lua_state, LUA_GCSTEP, 0);
+			steps++;
+		}
+	}
+	else if (gc_cycle_in_progress || memory_used >= gc_memory_after_cycle * gc_pause / 100) {
+		// Do not start a new cycle before memory grows past the pause threshold, just like Lua's own scheduler
+		while (true) {
+			bool cycle_finished = lua_gc(lua_state, LUA_GCSTEP, gc_step_size_kilobytes);
+			steps++;
+			if (cycle_finished) {
+				gc_cycle_in_progress = false;
+				gc_memory_after_cycle = get_memory_used();
+				gc_completed_cycles++;
+				break;
+			}
+			gc_cycle_in_progress = true;
+			if (time->get_ticks_usec() - start_usec >= (uint64_t) budget_usec) {
+				break;
+			}
+		}
+	}
+
+	int64_t elapsed_usec = time->get_ticks_usec() - start_usec;
+	if (steps > 0 && gc_mode != GC_MODE_GENERATIONAL) {
+		// Adapt step size so that each step takes about a quarter of the budget,
+		// while doing at least as much work as what was allocated since the last frame
+		double step_usec = MAX((double) elapsed_usec / steps, 1.0);
+		double time_based_kilobytes = gc_step_size_kilobytes * (budget_usec / 4.0) / step_usec;
+		double allocation_based_kilobytes = allocated_kilobytes / 4.0;
+		int target_kilobytes = (int) MAX(time_based_kilobytes, allocation_based_kilobytes);
+		gc_step_size_kilobytes = CLAMP((gc_step_size_kilobytes + target_kilobytes) / 2, 1, 1024);
+	}
+
+	gc_memory_at_last_step = get_memory_used();
+	gc_last_step_usec = elapsed_usec;
+	gc_last_step_count = steps;
+	gc_total_usec += elapsed_usec;
+	monitor_values.gc_last_step_usec.store(elapsed_usec, std::memory_order_relaxed);
+	monitor_values.gc_last_step_count.store(steps, std::memory_order_relaxed);
+	monitor_values.memory_used.store(gc_memory_at_last_step, std::memory_order_relaxed);
+	return elapsed_usec;
+}
+
+int64_t LuaState::get_gc_frame_budget_usec() const {
+	return gc_frame_budget_usec;
+}
+
+void LuaState::set_gc_frame_budget_usec(int64_t budget_usec) {
+	gc_frame_budget_usec = MAX(budget_usec, 0);
+	std::lock_guard lock(gc_scheduled_states_mutex);
+	if (gc_frame_budget_usec > 0) {
+		gc_scheduled_states.insert(this);
+	}
+	else {
+		gc_scheduled_states.erase(this);
+	}
+}
+
+Dictionary LuaState::get_gc_stats() const {
+	Dictionary stats;
+	stats["last_frame_usec"] = gc_last_step_usec;
+	stats["last_frame_steps"] = gc_last_step_count;
+	stats["total_usec"] = gc_total_usec;
+	stats["step_size_kilobytes"] = gc_step_size_kilobytes;
+	stats["completed_cycles"] = gc_completed_cycles;
+	return stats;
+}
+
+void LuaState::add_performance_monitors(const String& name) {
+	ERR_FAIL_COND_MSG(name.is_empty(), "Performance monitors name must not be empty");
+	remove_performance_monitors();
+	register_lua_state_performance_monitors(name, get_instance_id());
+	performance_monitors_name = name;
+}
+
+void LuaState::remove_performance_monitors() {
+	if (!performance_monitors_name.is_empty()) {
+		unregister_lua_state_performance_monitors(performance_monitors_name);
+		performance_monitors_name = String();
+	}
+}
+
+const LuaState::MonitorValues& LuaState::get_monitor_values() const {
+	return monitor_values;
+}
+
+void LuaState::publish_memory_used() {
+	monitor_values.memory_used.store(get_memory_used(), std::memory_order_relaxed);
+}
+
+void LuaState::publish_coroutine_pool_size(int size) {
+	monitor_values.coroutine_pool_size.store(size, std::memory_order_relaxed);
+#ifdef LUAJIT
+	// LuaJIT uses its own allocator, so memory usage is only published at safe points like this one
+	publish_memory_used();
+#endif
+}
+
+void LuaState::process_gc_frame() {
+	// Hold references while stepping, since finalizers may release other LuaStates
+	LocalVector<Ref<LuaState>> states;
+	{
+		std::lock_guard lock(gc_scheduled_states_mutex);
+		for (LuaState *state : gc_scheduled_states) {
+			// States being destroyed in other threads fail to be referenced
+			Ref<LuaState> state_ref = state;
+			if (state_ref.is_valid()) {
+				states.push_back(state_ref);
+			}
+		}
+	}
+	for (const Ref<LuaState>& state : states) {
+		state->step_gc_with_budget(state->gc_frame_budget_usec);
+	}
+}
+
 String LuaState::get_lua_runtime() {
 #ifdef LUAJIT
 	return "luajit";
@@ -370,8 +588,160 @@ String LuaState::get_lua_exec_dir() {
 		: OS::get_singleton()->get_executable_path().get_base_dir();
 }
 
+void LuaState::start_coverage() {
+	coverage.start(lua_state);
+}
+
+void LuaState::stop_coverage() {
+	coverage.stop();
+}
+
+void LuaState::clear_coverage() {
+	coverage.clear();
+}
+
+bool LuaState::is_coverage_running() const {
+	return coverage.is_running();
+}
+
+Dictionary LuaState::get_coverage() const {
+	return coverage.get_line_hits();
+}
+
+String LuaState::get_coverage_lcov(const String& test_name) const {
+	return coverage.to_lcov(test_name);
+}
+
+void LuaState::start_jit_trace_diagnostics() {
+	jit_trace_diagnostics.start(lua_state);
+}
+
+void LuaState::stop_jit_trace_diagnostics() {
+	jit_trace_diagnostics.stop();
+}
+
+void LuaState::clear_jit_trace_diagnostics() {
+	jit_trace_diagnostics.clear();
+}
+
+bool LuaState::is_jit_trace_diagnostics_running() const {
+	return jit_trace_diagnostics.is_running();
+}
+
+Dictionary LuaState::get_jit_trace_aborts() const {
+	return jit_trace_diagnostics.get_aborts();
+}
+
+Dictionary LuaState::get_jit_trace_stats() const {
+	return jit_trace_diagnostics.get_stats();
+}
+
+void LuaState::set_allocation_profiler(LuaAllocationProfiler *profiler) {
+	allocation_profiler = profiler;
+}
+
+void LuaState::reset_hooks() {
+	hook_dispatcher.remove_all();
+	update_memory_soft_limit_hook();
+}
+
+void LuaState::reset_settings() {
+	memory_soft_limit = 0;
+	memory_limit = 0;
+	memory_soft_limit_reached = false;
+	memory_soft_limit_pending = false;
+	update_memory_soft_limit_hook();
+	set_gc_frame_budget_usec(0);
+	remove_performance_monitors();
+	coverage.stop();
+	coverage.clear();
+	jit_trace_diagnostics.stop();
+	jit_trace_diagnostics.clear();
+}
+
+void LuaState::update_memory_soft_limit_hook() {
+#ifndef LUAJIT
+	if (memory_soft_limit > 0) {
+		hook_dispatcher.add(&memory_soft_limit, memory_soft_limit_hook, this, LUA_MASKCOUNT, MEMORY_SOFT_LIMIT_CHECK_INSTRUCTIONS);
+	}
+	else {
+		hook_dispatcher.remove(&memory_soft_limit);
+	}
+#endif
+}
+
+/// Collecting garbage is not safe inside the allocator, which may be called by the collector itself,
+/// so the full collection runs in a count hook after the allocation that crossed the soft limit.
+void LuaState::memory_soft_limit_hook(lua_State *L, lua_Debug *ar, void *lua_state) {
+	LuaState *self = (LuaState *) lua_state;
+	if (self->memory_soft_limit_pending) {
+		self->memory_soft_limit_pending = false;
+		lua_gc(L, LUA_GCCOLLECT, 0);
+	}
+}
+
+/// Lua memory allocation callback.
+/// `ud` is the LuaState, which tracks memory usage and enforces memory limits.
+void *LuaState::lua_alloc(void *ud, void *ptr, size_t osize, size_t nsize) {
+	LuaState *self = (LuaState *) ud;
+	// When `ptr` is NULL, Lua passes the type of the object being created in `osize`
+	size_t old_size = ptr != nullptr ? osize : 0;
+
+	// Shrinking blocks never fail
+	if (nsize > old_size) {
+		uint64_t new_total = self->memory_in_use - old_size + nsize;
+		if (self->memory_limit > 0 && new_total > self->memory_limit) {
+			// Lua runs an emergency full GC and retries before raising "not enough memory"
+			self->failed_allocation_count++;
+			return nullptr;
+		}
+		if (self->memory_soft_limit > 0 && new_total > self->memory_soft_limit && !self->memory_soft_limit_reached) {
+			// Allocations never fail because of the soft limit, a full GC runs in `memory_soft_limit_hook` instead.
+			// Only collect again after memory usage goes back below the soft limit.
+			self->memory_soft_limit_reached = true;
+			self->memory_soft_limit_pending = true;
+		}
+	}
+
+	void *new_ptr;
+	if (self->allocator == ALLOCATOR_POOL) {
+		new_ptr = self->pool_allocator.reallocate(ptr, osize, nsize);
+	}
+	else if (nsize == 0) {
+		if (ptr != nullptr) {
+			memfree(ptr);
+		}
+		new_ptr = nullptr;
+	}
+	else {
+		new_ptr = memrealloc(ptr, nsize);
+	}
+
+	if (new_ptr == nullptr && nsize > 0) {
+		self->failed_allocation_count++;
+		return nullptr;
+	}
+
+	self->memory_in_use = self->memory_in_use - old_size + nsize;
+	self->monitor_values.memory_used.store(self->memory_in_use, std::memory_order_relaxed);
+	if (self->memory_in_use > self->memory_peak) {
+		self->memory_peak = self->memory_in_use;
+	}
+	if (ptr == nullptr && nsize > 0) {
+		self->allocation_count++;
+	}
+	if (self->memory_soft_limit_reached && self->memory_in_use <= self->memory_soft_limit) {
+		self->memory_soft_limit_reached = false;
+	}
+	if (self->allocation_profiler) {
+		self->allocation_profiler->record_reallocation(ptr, new_ptr, nsize);
+	}
+	return new_ptr;
+}
+
 LuaState *LuaState::find_lua_state(lua_State *L) {
 	L = sol::main_thread(L, L);
+	std::shared_lock lock(valid_states_mutex);
 	if (LuaState **ptr = valid_states.getptr(L)) {
 		return *ptr;
 	}
@@ -414,6 +784,10 @@ void LuaState::_bind_methods() {
 	BIND_ENUM_CONSTANT(GC_MODE_INCREMENTAL);
 	BIND_ENUM_CONSTANT(GC_MODE_GENERATIONAL);
 
+	// Allocator enum
+	BIND_ENUM_CONSTANT(ALLOCATOR_DEFAULT);
+	BIND_ENUM_CONSTANT(ALLOCATOR_POOL);
+
 	// Methods
 	ClassDB::bind_method(D_METHOD("open_libraries", "libraries"), &LuaState::open_libraries, DEFVAL(BitField<Library>(ALL_LIBS)));
 	ClassDB::bind_method(D_METHOD("are_libraries_opened", "libraries"), &LuaState::are_libraries_opened);
@@ -426,6 +800,8 @@ void LuaState::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("do_buffer", "chunk", "chunkname", "mode", "env"), &LuaState::do_buffer, DEFVAL(""), DEFVAL(LOAD_MODE_ANY), DEFVAL(nullptr));
 	ClassDB::bind_method(D_METHOD("do_string", "chunk", "chunkname", "env"), &LuaState::do_string, DEFVAL(""), DEFVAL(nullptr));
 	ClassDB::bind_method(D_METHOD("do_file", "filename", "mode", "env"), &LuaState::do_file, DEFVAL(LOAD_MODE_ANY), DEFVAL(nullptr));
+	ClassDB::bind_method(D_METHOD("call_with_budget", "function", "arguments", "max_instructions"), &LuaState::call_with_budget);
+	ClassDB::bind_method(D_METHOD("parallel_map", "function_source", "packed_array", "chunk_size"), &LuaState::parallel_map, DEFVAL(1024));
 	
 	ClassDB::bind_method(D_METHOD("get_globals"), &LuaState::get_globals);
 	ClassDB::bind_method(D_METHOD("get_registry"), &LuaState::get_registry);
@@ -445,6 +821,36 @@ void LuaState::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("change_gc_mode_incremental", "pause", "step_multiplier", "step_byte_size"), &LuaState::change_gc_mode_incremental);
 	ClassDB::bind_method(D_METHOD("change_gc_mode_generational", "minor_multiplier", "major_multiplier"), &LuaState::change_gc_mode_generational);
 	ClassDB::bind_method(D_METHOD("supports_gc_mode", "gc_mode"), &LuaState::supports_gc_mode);
+	ClassDB::bind_method(D_METHOD("step_gc_with_budget", "budget_usec"), &LuaState::step_gc_with_budget);
+	ClassDB::bind_method(D_METHOD("get_gc_frame_budget_usec"), &LuaState::get_gc_frame_budget_usec);
+	ClassDB::bind_method(D_METHOD("set_gc_frame_budget_usec", "budget_usec"), &LuaState::set_gc_frame_budget_usec);
+	ClassDB::bind_method(D_METHOD("get_gc_stats"), &LuaState::get_gc_stats);
+	ClassDB::bind_method(D_METHOD("add_performance_monitors", "name"), &LuaState::add_performance_monitors);
+	ClassDB::bind_method(D_METHOD("remove_performance_monitors"), &LuaState::remove_performance_monitors);
+	ClassDB::bind_method(D_METHOD("get_memory_peak"), &LuaState::get_memory_peak);
+	ClassDB::bind_method(D_METHOD("reset_memory_peak"), &LuaState::reset_memory_peak);
+	ClassDB::bind_method(D_METHOD("get_allocation_count"), &LuaState::get_allocation_count);
+	ClassDB::bind_method(D_METHOD("get_failed_allocation_count"), &LuaState::get_failed_allocation_count);
+	ClassDB::bind_method(D_METHOD("get_memory_soft_limit"), &LuaState::get_memory_soft_limit);
+	ClassDB::bind_method(D_METHOD("set_memory_soft_limit", "limit"), &LuaState::set_memory_soft_limit);
+	ClassDB::bind_method(D_METHOD("get_memory_limit"), &LuaState::get_memory_limit);
+	ClassDB::bind_method(D_METHOD("set_memory_limit", "limit"), &LuaState::set_memory_limit);
+	ClassDB::bind_method(D_METHOD("get_allocator"), &LuaState::get_allocator);
+	ClassDB::bind_method(D_METHOD("get_allocator_stats"), &LuaState::get_allocator_stats);
+	ClassDB::bind_method(D_METHOD("start_coverage"), &LuaState::start_coverage);
+	ClassDB::bind_method(D_METHOD("stop_coverage"), &LuaState::stop_coverage);
+	ClassDB::bind_method(D_METHOD("clear_coverage"), &LuaState::clear_coverage);
+	ClassDB::bind_method(D_METHOD("is_coverage_running"), &LuaState::is_coverage_running);
+	ClassDB::bind_method(D_METHOD("get_coverage"), &LuaState::get_coverage);
+	ClassDB::bind_method(D_METHOD("get_coverage_lcov", "test_name"), &LuaState::get_coverage_lcov, DEFVAL(""));
+	ClassDB::bind_method(D_METHOD("start_jit_trace_diagnostics"), &LuaState::start_jit_trace_diagnostics);
+	ClassDB::bind_method(D_METHOD("stop_jit_trace_diagnostics"), &LuaState::stop_jit_trace_diagnostics);
+	ClassDB::bind_method(D_METHOD("clear_jit_trace_diagnostics"), &LuaState::clear_jit_trace_diagnostics);
+	ClassDB::bind_method(D_METHOD("is_jit_trace_diagnostics_running"), &LuaState::is_jit_trace_diagnostics_running);
+	ClassDB::bind_method(D_METHOD("get_jit_trace_aborts"), &LuaState::get_jit_trace_aborts);
+	ClassDB::bind_method(D_METHOD("get_jit_trace_stats"), &LuaState::get_jit_trace_stats);
+
+	ClassDB::bind_static_method(LuaState::get_class_static(), D_METHOD("create", "allocator"), &LuaState::create);
 
 	ClassDB::bind_static_method(LuaState::get_class_static(), D_METHOD("get_lua_runtime"), &LuaState::get_lua_runtime);
 	ClassDB::bind_static_method(LuaState::get_class_static(), D_METHOD("get_lua_version_num"), &LuaState::get_lua_version_num);
@@ -457,6 +863,10 @@ void LuaState::_bind_methods() {
 	ADD_PROPERTY(PropertyInfo(Variant::OBJECT, "main_thread", PROPERTY_HINT_NONE, "", PROPERTY_USAGE_NONE, LuaThread::get_class_static()), "", "get_main_thread");
 	ADD_PROPERTY(PropertyInfo(Variant::STRING, "package_path", PROPERTY_HINT_NONE, "", PROPERTY_USAGE_NONE), "set_package_path", "get_package_path");
 	ADD_PROPERTY(PropertyInfo(Variant::STRING, "package_cpath", PROPERTY_HINT_NONE, "", PROPERTY_USAGE_NONE), "set_package_cpath", "get_package_cpath");
+	ADD_PROPERTY(PropertyInfo(Variant::INT, "gc_frame_budget_usec", PROPERTY_HINT_NONE, "suffix:usec", PROPERTY_USAGE_NONE), "set_gc_frame_budget_usec", "get_gc_frame_budget_usec");
+	ADD_PROPERTY(PropertyInfo(Variant::INT, "memory_soft_limit", PROPERTY_HINT_NONE, "suffix:bytes", PROPERTY_USAGE_NONE), "set_memory_soft_limit", "get_memory_soft_limit");
+	ADD_PROPERTY(PropertyInfo(Variant::INT, "memory_limit", PROPERTY_HINT_NONE, "suffix:bytes", PROPERTY_USAGE_NONE), "set_memory_limit", "get_memory_limit");
+	ADD_PROPERTY(PropertyInfo(Variant::INT, "allocator", PROPERTY_HINT_ENUM, "Default,Pool", PROPERTY_USAGE_NONE), "", "get_allocator");
 }
 
 LuaState::operator String() const {
@@ -468,5 +878,8 @@ String LuaState::_to_string() const {
 }
 
 HashMap<lua_State *, LuaState *> LuaState::valid_states;
+std::shared_mutex LuaState::valid_states_mutex;
+HashSet<LuaState *> LuaState::gc_scheduled_states;
+std::mutex LuaState::gc_scheduled_states_mutex;
 
 }
@@ -23,14 +23,24 @@
 #define __LUA_STATE_HPP__
 
 #include "utils/custom_sol.hpp"
+#include "utils/LuaCoverage.hpp"
+#include "utils/LuaHookDispatcher.hpp"
+#include "utils/LuaJitTraceDiagnostics.hpp"
+#include "utils/LuaPoolAllocator.hpp"
+
+#include <atomic>
+#include <mutex>
+#include <shared_mutex>
 
 #include <godot_cpp/classes/ref_counted.hpp>
 #include <godot_cpp/templates/hash_map.hpp>
+#include <godot_cpp/templates/hash_set.hpp>
 
 using namespace godot;
 
 namespace luagdextension {
 
+class LuaAllocationProfiler;
 class LuaFunction;
 class LuaTable;
 class LuaThread;
@@ -102,9 +112,19 @@ public:
 		GC_MODE_GENERATIONAL = (int) sol::gc_mode::generational,
 	};
 
+	enum Allocator {
+		// Godot's memory functions, or LuaJIT's builtin allocator
+		ALLOCATOR_DEFAULT,
+		// Size-class free lists for small blocks. Not supported in LuaJIT.
+		ALLOCATOR_POOL,
+	};
+
 	LuaState();
+	LuaState(Allocator allocator);
 	virtual ~LuaState();
 
+	static Ref<LuaState> create(Allocator allocator);
+
 	sol::state_view get_lua_state() const;
 
 	void open_libraries(BitField<Library> libraries = ALL_LIBS);
@@ -118,6 +138,8 @@ public:
 	Variant do_buffer(const PackedByteArray& chunk, const String& chunkname = "", LoadMode mode = LOAD_MODE_ANY, LuaTable *env = nullptr);
 	Variant do_string(const String& chunk, const String& chunkname = "", LuaTable *env = nullptr);
 	Variant do_file(const String& filename, LoadMode mode = LOAD_MODE_ANY, LuaTable *env = nullptr);
+	Variant call_with_budget(LuaFunction *function, const Array& args, int64_t max_instructions);
+	Variant parallel_map(const String& function_source, const Variant& packed_array, int64_t chunk_size = 1024);
 
 	Ref<LuaTable> get_globals() const;
 	Ref<LuaTable> get_registry() const;
@@ -134,9 +156,40 @@ public:
 	void restart_gc();
 	bool is_gc_running() const;
 	uint64_t get_memory_used() const;
+	uint64_t get_memory_peak() const;
+	void reset_memory_peak();
+	uint64_t get_allocation_count() const;
+	uint64_t get_failed_allocation_count() const;
+	uint64_t get_memory_soft_limit() const;
+	void set_memory_soft_limit(uint64_t limit);
+	uint64_t get_memory_limit() const;
+	void set_memory_limit(uint64_t limit);
+	Allocator get_allocator() const;
+	Dictionary get_allocator_stats() const;
 	GcMode change_gc_mode_incremental(int pause, int step_multiplier, int step_byte_size);
 	GcMode change_gc_mode_generational(int minor_multiplier, int major_multiplier);
 	bool supports_gc_mode(GcMode mode) const;
+	int64_t step_gc_with_budget(int64_t budget_usec);
+	int64_t get_gc_frame_budget_usec() const;
+	void set_gc_frame_budget_usec(int64_t budget_usec);
+	Dictionary get_gc_stats() const;
+
+	void add_performance_monitors(const String& name);
+	void remove_performance_monitors();
+
+	void start_coverage();
+	void stop_coverage();
+	void clear_coverage();
+	bool is_coverage_running() const;
+	Dictionary get_coverage() const;
+	String get_coverage_lcov(const String& test_name = "") const;
+
+	void start_jit_trace_diagnostics();
+	void stop_jit_trace_diagnostics();
+	void clear_jit_trace_diagnostics();
+	bool is_jit_trace_diagnostics_running() const;
+	Dictionary get_jit_trace_aborts() const;
+	Dictionary get_jit_trace_stats() const;
 
 #ifdef HAVE_LUA_WARN
 	void warn(const char *msg, int tocont);
@@ -149,26 +202,90 @@ public:
 	static String get_lua_version_string();
 
 	static String get_lua_exec_dir();
+	void set_allocation_profiler(LuaAllocationProfiler *profiler);
+	// Removes every debug hook, except the ones used internally by this LuaState
+	void reset_hooks();
+	// Restores memory limits, GC budget, monitors, coverage and JIT diagnostics to their defaults
+	void reset_settings();
+
 	static LuaState *find_lua_state(lua_State *L);
 
+	// Values read by Performance monitors in the main thread, while this state may be running in another thread.
+	// They are published by the thread running the state, monitors never touch the Lua state directly.
+	struct MonitorValues {
+		std::atomic<uint64_t> memory_used = 0;
+		std::atomic<int64_t> gc_last_step_usec = 0;
+		std::atomic<int> gc_last_step_count = 0;
+		std::atomic<int> coroutine_pool_size = 0;
+	};
+	const MonitorValues& get_monitor_values() const;
+	// Must be called by the thread running this state
+	void publish_memory_used();
+	void publish_coroutine_pool_size(int size);
+	static void process_gc_frame();
+
 protected:
 	static void _bind_methods();
 
 	String _to_string() const;
 
+	// Allocator and memory accounting must be declared before `lua_state`, so that they outlive `lua_close`
+	Allocator allocator;
+	LuaPoolAllocator pool_allocator;
+	uint64_t memory_in_use = 0;
+	uint64_t memory_peak = 0;
+	uint64_t allocation_count = 0;
+	uint64_t failed_allocation_count = 0;
+	uint64_t memory_soft_limit = 0;
+	uint64_t memory_limit = 0;
+	bool memory_soft_limit_reached = false;
+	// Set by the allocator, a full GC runs in the next soft limit hook
+	bool memory_soft_limit_pending = false;
+	LuaAllocationProfiler *allocation_profiler = nullptr;
 	sol::state lua_state;
+	// Declared after `lua_state`, so that they stop before `lua_close`
+	LuaHookDispatcher hook_dispatcher;
+	LuaCoverage coverage;
+	LuaJitTraceDiagnostics jit_trace_diagnostics;
+
+	// GC scheduler
+	GcMode gc_mode = GC_MODE_INCREMENTAL;
+	int gc_pause = 200;
+	int gc_step_size_kilobytes = 8;
+	bool gc_cycle_in_progress = false;
+	uint64_t gc_memory_after_cycle = 0;
+	uint64_t gc_memory_at_last_step = 0;
+	int64_t gc_frame_budget_usec = 0;
+	int64_t gc_last_step_usec = 0;
+	int gc_last_step_count = 0;
+	int64_t gc_total_usec = 0;
+	uint64_t gc_completed_cycles = 0;
+
+	// Name used in "Lua (name)/*" Performance monitors, empty if they were not added
+	String performance_monitors_name;
+	MonitorValues monitor_values;
+
 #ifdef HAVE_LUA_WARN
 	bool warning_on = true;
 	String warn_message;
 #endif
 
 private:
+	static void *lua_alloc(void *ud, void *ptr, size_t osize, size_t nsize);
+	void update_memory_soft_limit_hook();
+	static void memory_soft_limit_hook(lua_State *L, lua_Debug *ar, void *lua_state);
+
+	// LuaStates may be created and destroyed in any thread
 	static HashMap<lua_State *, LuaState *> valid_states;
+	static std::shared_mutex valid_states_mutex;
+	static HashSet<LuaState *> gc_scheduled_states;
+	static std::mutex gc_scheduled_states_mutex;
 };
 
 }
 VARIANT_BITFIELD_CAST(luagdextension::LuaState::Library);
 VARIANT_ENUM_CAST(luagdextension::LuaState::LoadMode);
 VARIANT_ENUM_CAST(luagdextension::LuaState::GcMode);
+VARIANT_ENUM_CAST(luagdextension::LuaState::Allocator);
 
 #endif
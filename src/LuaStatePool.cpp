@@ -0,0 +1,294 @@
+/**
+ * Copyright (C) 2026 Gil Barbosa Reis.
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the “Software”), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ * of the Software, and to permit persons to whom the Software is furnished to do
+ * so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#include "LuaStatePool.hpp"
+
+#include "utils/LuaCoroutinePool.hpp"
+#include "utils/stack_top_checker.hpp"
+
+namespace luagdextension {
+
+static const char BASELINE_KEY[] = "_GDEXTENSION_BASELINE";
+
+/// Pushes a shallow copy of the table at `index`.
+/// If `only_string_keys` is true, other keys are skipped, which is used for the registry to avoid touching references.
+static void push_shallow_copy(lua_State *L, int index, bool only_string_keys) {
+	index = lua_absindex(L, index);
+	lua_newtable(L);
+	lua_pushnil(L);
+	while (lua_next(L, index)) {
+		if (!only_string_keys || lua_type(L, -2) == LUA_TSTRING) {
+			lua_pushvalue(L, -2);
+			lua_insert(L, -2);
+			lua_rawset(L, -4);  // copy[key] = value
+		}
+		else {
+			lua_pop(L, 1);
+		}
+	}
+}
+
+/// Records the contents and metatable of the table at `index`, unless it was already recorded.
+static void snapshot_table(lua_State *L, int tables, int metatables, int index) {
+	index = lua_absindex(L, index);
+	lua_pushvalue(L, index);
+	if (lua_rawget(L, tables) != LUA_TNIL) {
+		lua_pop(L, 1);
+		return;
+	}
+	lua_pop(L, 1);
+
+	lua_pushvalue(L, index);
+	push_shallow_copy(L, index, false);
+	lua_rawset(L, tables);  // tables[t] = copy
+
+	lua_pushvalue(L, index);
+	if (!lua_getmetatable(L, index)) {
+		lua_pushboolean(L, false);
+	}
+	lua_rawset(L, metatables);  // metatables[t] = metatable or false
+}
+
+/// Snapshot every table value stored in the table at `index`.
+static void snapshot_table_values(lua_State *L, int tables, int metatables, int index, bool only_string_keys) {
+	index = lua_absindex(L, index);
+	lua_pushnil(L);
+	while (lua_next(L, index)) {
+		if (lua_type(L, -1) == LUA_TTABLE && (!only_string_keys || lua_type(L, -2) == LUA_TSTRING)) {
+			snapshot_table(L, tables, metatables, -1);
+		}
+		lua_pop(L, 1);
+	}
+}
+
+/// Makes the table at `index` have exactly the same entries as the table at `copy`.
+static void restore_table(lua_State *L, int index, int copy, bool only_string_keys) {
+	index = lua_absindex(L, index);
+	copy = lua_absindex(L, copy);
+
+	// remove entries added after the snapshot
+	lua_pushnil(L);
+	while (lua_next(L, index)) {
+		lua_pop(L, 1);
+		if (only_string_keys && lua_type(L, -1) != LUA_TSTRING) {
+			continue;
+		}
+		lua_pushvalue(L, -1);
+		if (lua_rawget(L, copy) == LUA_TNIL) {
+			// clearing existing fields while traversing with lua_next is allowed
+			lua_pushvalue(L, -2);
+			lua_pushnil(L);
+			lua_rawset(L, index);
+		}
+		lua_pop(L, 1);
+	}
+
+	// restore original values
+	lua_pushnil(L);
+	while (lua_next(L, copy)) {
+		lua_pushvalue(L, -2);
+		lua_insert(L, -2);
+		lua_rawset(L, index);
+	}
+}
+
+/// Captures globals, registry string keys and every table directly reachable from them.
+static void save_baseline(lua_State *L) {
+	StackTopChecker topcheck(L);
+	lua_createtable(L, 0, 3);
+	int baseline = lua_gettop(L);
+	lua_newtable(L);
+	int tables = lua_gettop(L);
+	lua_newtable(L);
+	int metatables = lua_gettop(L);
+
+	lua_pushglobaltable(L);
+	snapshot_table(L, tables, metatables, -1);
+	snapshot_table_values(L, tables, metatables, -1, false);
+	lua_pop(L, 1);
+
+	snapshot_table_values(L, tables, metatables, LUA_REGISTRYINDEX, true);
+	push_shallow_copy(L, LUA_REGISTRYINDEX, true);
+	lua_setfield(L, baseline, "registry");
+
+	lua_setfield(L, baseline, "metatables");
+	lua_setfield(L, baseline, "tables");
+	lua_setfield(L, LUA_REGISTRYINDEX, BASELINE_KEY);
+}
+
+static bool restore_baseline(lua_State *L) {
+	StackTopChecker topcheck(L);
+	if (lua_getfield(L, LUA_REGISTRYINDEX, BASELINE_KEY) != LUA_TTABLE) {
+		lua_pop(L, 1);
+		return false;
+	}
+	int baseline = lua_gettop(L);
+
+	lua_getfield(L, baseline, "registry");
+	restore_table(L, LUA_REGISTRYINDEX, -1, true);
+	lua_pop(L, 1);
+	// the baseline itself was not part of the snapshot
+	lua_pushvalue(L, baseline);
+	lua_setfield(L, LUA_REGISTRYINDEX, BASELINE_KEY);
+
+	lua_getfield(L, baseline, "tables");
+	lua_getfield(L, baseline, "metatables");
+	int tables = lua_absindex(L, -2);
+	int metatables = lua_absindex(L, -1);
+	lua_pushnil(L);
+	while (lua_next(L, tables)) {
+		restore_table(L, -2, -1, false);
+		lua_pop(L, 1);
+
+		lua_pushvalue(L, -1);
+		lua_rawget(L, metatables);
+		if (!lua_istable(L, -1)) {
+			lua_pop(L, 1);
+			lua_pushnil(L);
+		}
+		lua_setmetatable(L, -2);
+	}
+	lua_pop(L, 3);
+	return true;
+}
+
+LuaStatePool::LuaStatePool()
+	: libraries(LuaState::ALL_LIBS)
+	, max_size(16)
+{
+}
+
+BitField<LuaState::Library> LuaStatePool::get_libraries() const {
+	return libraries;
+}
+
+void LuaStatePool::set_libraries(BitField<LuaState::Library> libraries) {
+	if (this->libraries != libraries) {
+		this->libraries = libraries;
+		// States opened with the previous libraries are not valid anymore
+		clear();
+	}
+}
+
+int LuaStatePool::get_max_size() const {
+	return max_size;
+}
+
+void LuaStatePool::set_max_size(int max_size) {
+	ERR_FAIL_COND_MSG(max_size < 0, "Max size cannot be negative");
+	this->max_size = max_size;
+	if (available_states.size() > max_size) {
+		available_states.resize(max_size);
+	}
+}
+
+int LuaStatePool::get_available_count() const {
+	return available_states.size();
+}
+
+void LuaStatePool::prewarm(int count) {
+	count = MIN(count, max_size);
+	while (available_states.size() < count) {
+		available_states.push_back(create_state());
+	}
+}
+
+Ref<LuaState> LuaStatePool::acquire() {
+	Ref<LuaState> lua_state;
+	if (int64_t size = available_states.size(); size > 0) {
+		lua_state = available_states[size - 1];
+		available_states.remove_at(size - 1);
+	}
+	else {
+		lua_state = create_state();
+	}
+	prune_acquired_states();
+	acquired_states.insert(lua_state->get_instance_id(), libraries);
+	return lua_state;
+}
+
+void LuaStatePool::release(LuaState *lua_state) {
+	ERR_FAIL_COND_MSG(lua_state == nullptr, "LuaState cannot be null");
+	const int64_t *state_libraries = acquired_states.getptr(lua_state->get_instance_id());
+	ERR_FAIL_COND_MSG(state_libraries == nullptr, "LuaState was not acquired from this LuaStatePool or was already released");
+	bool outdated = *state_libraries != libraries;
+	acquired_states.erase(lua_state->get_instance_id());
+	// States opened with previous libraries are discarded
+	if (outdated) {
+		return;
+	}
+	if (available_states.size() >= max_size) {
+		WARN_PRINT_ONCE("LuaStatePool is full, released LuaStates are being discarded. Increase max_size to reuse more states.");
+		return;
+	}
+
+	lua_State *L = lua_state->get_lua_state();
+	lua_settop(L, 0);
+	lua_state->reset_settings();
+	lua_state->reset_hooks();
+	ERR_FAIL_COND_MSG(!restore_baseline(L), "LuaState was not created by a LuaStatePool");
+	lua_state->publish_coroutine_pool_size(LuaCoroutinePool(L).get_size());
+	lua_state->publish_memory_used();
+	available_states.push_back(lua_state);
+}
+
+void LuaStatePool::clear() {
+	available_states.clear();
+}
+
+/// Forgets states that were acquired and then freed without being released
+void LuaStatePool::prune_acquired_states() {
+	LocalVector<uint64_t> freed_states;
+	for (const KeyValue<uint64_t, int64_t>& it : acquired_states) {
+		if (ObjectDB::get_instance(ObjectID(it.key)) == nullptr) {
+			freed_states.push_back(it.key);
+		}
+	}
+	for (uint64_t instance_id : freed_states) {
+		acquired_states.erase(instance_id);
+	}
+}
+
+Ref<LuaState> LuaStatePool::create_state() const {
+	Ref<LuaState> lua_state;
+	lua_state.instantiate();
+	lua_state->open_libraries(libraries);
+	save_baseline(lua_state->get_lua_state());
+	return lua_state;
+}
+
+void LuaStatePool::_bind_methods() {
+	ClassDB::bind_method(D_METHOD("get_libraries"), &LuaStatePool::get_libraries);
+	ClassDB::bind_method(D_METHOD("set_libraries", "libraries"), &LuaStatePool::set_libraries);
+	ClassDB::bind_method(D_METHOD("get_max_size"), &LuaStatePool::get_max_size);
+	ClassDB::bind_method(D_METHOD("set_max_size", "max_size"), &LuaStatePool::set_max_size);
+	ClassDB::bind_method(D_METHOD("get_available_count"), &LuaStatePool::get_available_count);
+
+	ClassDB::bind_method(D_METHOD("prewarm", "count"), &LuaStatePool::prewarm);
+	ClassDB::bind_method(D_METHOD("acquire"), &LuaStatePool::acquire);
+	ClassDB::bind_method(D_METHOD("release", "lua_state"), &LuaStatePool::release);
+	ClassDB::bind_method(D_METHOD("clear"), &LuaStatePool::clear);
+
+	ADD_PROPERTY(PropertyInfo(Variant::INT, "libraries", PROPERTY_HINT_FLAGS, "", PROPERTY_USAGE_DEFAULT | PROPERTY_USAGE_CLASS_IS_BITFIELD, "LuaState.Library"), "set_libraries", "get_libraries");
+	ADD_PROPERTY(PropertyInfo(Variant::INT, "max_size"), "set_max_size", "get_max_size");
+}
+
+}
@@ -22,6 +22,7 @@
 #include "LuaThread.hpp"
 #include "LuaDebug.hpp"
 #include "LuaFunction.hpp"
+#include "utils/LuaHookDispatcher.hpp"
 #include "utils/convert_godot_lua.hpp"
 #include "utils/stack_top_checker.hpp"
 
@@ -29,7 +30,7 @@ namespace luagdextension {
 
 static const char *HOOKKEY = "_GD_HOOKKEY";
 
-static void hookf(lua_State *L, lua_Debug *ar) {
+static void hookf(lua_State *L, lua_Debug *ar, void *userdata) {
 	lua_getfield(L, LUA_REGISTRYINDEX, HOOKKEY);
 	lua_pushthread(L);
 	switch (lua_rawget(L, -2)) {
@@ -93,11 +94,14 @@ void LuaThread::set_hook(Variant hook, BitField<HookMask> mask, int count) {
 	lua_push(L, hook);  // value (hook)
 	lua_rawset(L, -3);  // hooktable[L] = hook
 	lua_pop(L, 1);
+	// Hooks are shared with profilers and coverage through the state's hook dispatcher
+	LuaHookDispatcher *dispatcher = LuaHookDispatcher::get(L);
+	ERR_FAIL_NULL(dispatcher);
 	if (hook && mask) {
-		lua_sethook(L, hookf, mask, count);
+		dispatcher->add(HOOKKEY, hookf, nullptr, mask, count, L);
 	}
 	else {
-		lua_sethook(L, nullptr, 0, 0);
+		dispatcher->remove(HOOKKEY, L);
 	}
 }
 
@@ -112,11 +116,21 @@ Variant LuaThread::get_hook() const {
 }
 
 BitField<LuaThread::HookMask> LuaThread::get_hook_mask() const {
-	return lua_gethookmask(lua_object.thread_state());
+	lua_State *L = lua_object.thread_state();
+	int mask = 0, count = 0;
+	if (LuaHookDispatcher *dispatcher = LuaHookDispatcher::get(L)) {
+		dispatcher->get_config(HOOKKEY, L, &mask, &count);
+	}
+	return mask;
 }
 
 int LuaThread::get_hook_count() const {
-	return lua_gethookcount(lua_object.thread_state());
+	lua_State *L = lua_object.thread_state();
+	int mask = 0, count = 0;
+	if (LuaHookDispatcher *dispatcher = LuaHookDispatcher::get(L)) {
+		dispatcher->get_config(HOOKKEY, L, &mask, &count);
+	}
+	return count;
 }
 
 Ref<LuaDebug> LuaThread::get_stack_level_info(int stack_level) const {
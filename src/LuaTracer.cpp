@@ -0,0 +1,268 @@
+/**
+ * Copyright (C) 2026 Gil Barbosa Reis.
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the “Software”), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ * of the Software, and to permit persons to whom the Software is furnished to do
+ * so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#include "LuaTracer.hpp"
+
+#include <chrono>
+#include <mutex>
+#include <thread>
+
+#include <godot_cpp/classes/file_access.hpp>
+#include <godot_cpp/classes/os.hpp>
+#include <godot_cpp/templates/hash_set.hpp>
+
+namespace luagdextension {
+
+static std::mutex buffers_mutex;
+
+static uint64_t get_ticks_nsec() {
+	return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+void LuaTracer::Scope::begin(const char *category, const char *label, const StringName *name) {
+	this->category = category;
+	this->label = label;
+	this->name = name;
+	start_nsec = get_ticks_nsec();
+}
+
+void LuaTracer::Scope::end() {
+	uint64_t end_nsec = get_ticks_nsec();
+	// Avoid allocating buffers for threads that only record events after tracing stopped
+	if (!running.load(std::memory_order_relaxed)) {
+		return;
+	}
+	ThreadBuffer *buffer = get_thread_buffer();
+	// Tracing might have stopped while inside the scope, and buffers may be being exported.
+	// `writing` is set before checking `running`, so exporting either sees the flag or this write sees tracing stopped.
+	buffer->writing.store(true);
+	if (!running.load()) {
+		buffer->writing.store(false, std::memory_order_release);
+		return;
+	}
+
+	uint64_t index = buffer->write_count.load(std::memory_order_relaxed);
+	Event& event = buffer->events[index % buffer->events.size()];
+	event.thread_id = buffer->thread_id;
+	event.category = category;
+	event.label = label;
+	event.name_id = name ? buffer->get_name_id(*name) : 0;
+	event.start_nsec = start_nsec;
+	event.duration_nsec = end_nsec - start_nsec;
+	buffer->write_count.store(index + 1, std::memory_order_release);
+	buffer->writing.store(false, std::memory_order_release);
+}
+
+uint32_t LuaTracer::ThreadBuffer::get_name_id(const StringName& name) {
+	if (const uint32_t *id = name_ids.getptr(name)) {
+		return *id;
+	}
+	names.push_back(name);
+	uint32_t id = names.size();
+	name_ids.insert(name, id);
+	return id;
+}
+
+void LuaTracer::ThreadBuffer::resize(uint64_t size) {
+	// Keep the most recent events, in order
+	uint64_t count = write_count.load(std::memory_order_relaxed);
+	uint64_t old_size = events.size();
+	uint64_t first = count > old_size ? count - old_size : 0;
+	uint64_t kept = MIN(count - first, size);
+	LocalVector<Event> resized;
+	resized.resize(size);
+	for (uint64_t i = 0; i < kept; i++) {
+		resized[i] = events[(count - kept + i) % old_size];
+	}
+	events = resized;
+	write_count.store(kept);
+}
+
+void LuaTracer::start(int events_per_thread) {
+	ERR_FAIL_COND_MSG(events_per_thread <= 0, "Events per thread must be positive");
+	// Holding the lock while starting makes exporting and starting exclusive
+	std::lock_guard<std::mutex> lock(buffers_mutex);
+	if (running.load()) {
+		return;
+	}
+	if (LuaTracer::events_per_thread != events_per_thread) {
+		// Not running, so no thread is writing events. Threads that started writing before stopping have finished in `stop`.
+		wait_for_writers();
+		for (ThreadBuffer *buffer : buffers) {
+			buffer->resize(events_per_thread);
+		}
+		LuaTracer::events_per_thread = events_per_thread;
+	}
+	running.store(true);
+}
+
+void LuaTracer::stop() {
+	running.store(false);
+}
+
+void LuaTracer::clear() {
+	std::lock_guard<std::mutex> lock(buffers_mutex);
+	ERR_FAIL_COND_MSG(is_running(), "Stop tracing before clearing events");
+	wait_for_writers();
+	LocalVector<ThreadBuffer *> owned_buffers;
+	for (ThreadBuffer *buffer : buffers) {
+		if (buffer->in_use) {
+			buffer->write_count.store(0);
+			buffer->name_ids.clear();
+			buffer->names.clear();
+			owned_buffers.push_back(buffer);
+		}
+		else {
+			// Buffers released by exited threads only held their events
+			memdelete(buffer);
+		}
+	}
+	buffers = owned_buffers;
+}
+
+bool LuaTracer::is_running() {
+	return running.load();
+}
+
+int LuaTracer::get_event_count() {
+	std::lock_guard<std::mutex> lock(buffers_mutex);
+	uint64_t count = 0;
+	for (ThreadBuffer *buffer : buffers) {
+		count += MIN(buffer->write_count.load(std::memory_order_acquire), (uint64_t) buffer->events.size());
+	}
+	return count;
+}
+
+String LuaTracer::get_trace_json() {
+	std::lock_guard<std::mutex> lock(buffers_mutex);
+	ERR_FAIL_COND_V_MSG(is_running(), String(), "Stop tracing before exporting events");
+	wait_for_writers();
+
+	uint64_t main_thread_id = OS::get_singleton()->get_main_thread_id();
+	PackedStringArray events;
+	HashSet<uint64_t> named_threads;
+	for (ThreadBuffer *buffer : buffers) {
+		// Once the ring buffer wraps around, the oldest event is the one at the write position
+		uint64_t write_count = buffer->write_count.load(std::memory_order_acquire);
+		uint64_t size = buffer->events.size();
+		uint64_t first = write_count > size ? write_count - size : 0;
+		for (uint64_t i = first; i < write_count; i++) {
+			const Event& event = buffer->events[i % size];
+			if (!named_threads.has(event.thread_id)) {
+				named_threads.insert(event.thread_id);
+				String thread_name = event.thread_id == main_thread_id ? String("Main Thread") : vformat("Thread %d", (int64_t) event.thread_id);
+				events.append(vformat("{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%d,\"args\":{\"name\":\"%s\"}}", (int64_t) event.thread_id, thread_name));
+			}
+			String name = event.name_id ? String(buffer->names[event.name_id - 1]).json_escape() : String(event.label);
+			events.append(vformat(
+				"{\"name\":\"%s\",\"cat\":\"%s\",\"ph\":\"X\",\"ts\":%s,\"dur\":%s,\"pid\":1,\"tid\":%d,\"args\":{\"site\":\"%s\"}}",
+				name,
+				event.category,
+				String::num(event.start_nsec / 1000.0, 3),
+				String::num(event.duration_nsec / 1000.0, 3),
+				(int64_t) event.thread_id,
+				event.label
+			));
+		}
+	}
+	return "{\"traceEvents\":[\n" + String(",\n").join(events) + "\n],\"displayTimeUnit\":\"ns\"}\n";
+}
+
+Error LuaTracer::save_trace(const String& path) {
+	ERR_FAIL_COND_V_MSG(is_running(), ERR_BUSY, "Stop tracing before exporting events");
+	Ref<FileAccess> file = FileAccess::open(path, FileAccess::WRITE);
+	if (file.is_null()) {
+		return FileAccess::get_open_error();
+	}
+	file->store_string(get_trace_json());
+	return OK;
+}
+
+void LuaTracer::free_buffers() {
+	running.store(false);
+	std::lock_guard<std::mutex> lock(buffers_mutex);
+	for (ThreadBuffer *buffer : buffers) {
+		memdelete(buffer);
+	}
+	buffers.clear();
+	thread_buffer.buffer = nullptr;
+}
+
+/// Waits for events that started being written before tracing stopped. Must be called with `buffers_mutex` locked.
+void LuaTracer::wait_for_writers() {
+	for (ThreadBuffer *buffer : buffers) {
+		while (buffer->writing.load(std::memory_order_acquire)) {
+			std::this_thread::yield();
+		}
+	}
+}
+
+LuaTracer::ThreadBuffer *LuaTracer::get_thread_buffer() {
+	if (thread_buffer.buffer == nullptr) {
+		uint64_t thread_id = OS::get_singleton()->get_thread_caller_id();
+
+		std::lock_guard<std::mutex> lock(buffers_mutex);
+		ThreadBuffer *buffer = nullptr;
+		for (ThreadBuffer *released_buffer : buffers) {
+			if (!released_buffer->in_use) {
+				buffer = released_buffer;
+				break;
+			}
+		}
+		if (buffer == nullptr) {
+			buffer = memnew(ThreadBuffer);
+			buffer->events.resize(events_per_thread);
+			buffers.push_back(buffer);
+		}
+		buffer->thread_id = thread_id;
+		buffer->in_use = true;
+		thread_buffer.buffer = buffer;
+	}
+	return thread_buffer.buffer;
+}
+
+LuaTracer::ThreadBufferOwner::~ThreadBufferOwner() {
+	if (buffer == nullptr) {
+		return;
+	}
+	std::lock_guard<std::mutex> lock(buffers_mutex);
+	// Buffers are freed when the extension is unloaded, maybe before this thread exits
+	if (buffers.find(buffer) >= 0) {
+		buffer->in_use = false;
+	}
+}
+
+void LuaTracer::_bind_methods() {
+	ClassDB::bind_static_method(get_class_static(), D_METHOD("start", "events_per_thread"), &LuaTracer::start, DEFVAL(65536));
+	ClassDB::bind_static_method(get_class_static(), D_METHOD("stop"), &LuaTracer::stop);
+	ClassDB::bind_static_method(get_class_static(), D_METHOD("clear"), &LuaTracer::clear);
+	ClassDB::bind_static_method(get_class_static(), D_METHOD("is_running"), &LuaTracer::is_running);
+	ClassDB::bind_static_method(get_class_static(), D_METHOD("get_event_count"), &LuaTracer::get_event_count);
+	ClassDB::bind_static_method(get_class_static(), D_METHOD("get_trace_json"), &LuaTracer::get_trace_json);
+	ClassDB::bind_static_method(get_class_static(), D_METHOD("save_trace", "path"), &LuaTracer::save_trace);
+}
+
+std::atomic<bool> LuaTracer::running = false;
+int LuaTracer::events_per_thread = 65536;
+LocalVector<LuaTracer::ThreadBuffer *> LuaTracer::buffers;
+thread_local LuaTracer::ThreadBufferOwner LuaTracer::thread_buffer;
+
+}
@@ -0,0 +1,136 @@
+/**
+ * Copyright (C) 2026 Gil Barbosa Reis.
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the “Software”), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ * of the Software, and to permit persons to whom the Software is furnished to do
+ * so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#ifndef __LUA_TRACER_HPP__
+#define __LUA_TRACER_HPP__
+
+#include <atomic>
+#include <cstdint>
+
+#include <godot_cpp/classes/ref_counted.hpp>
+#include <godot_cpp/templates/hash_map.hpp>
+#include <godot_cpp/templates/local_vector.hpp>
+
+using namespace godot;
+
+namespace luagdextension {
+
+/**
+ * Records Lua↔Godot boundary crossings as Chrome trace events.
+ *
+ * Each thread writes complete events to its own ring buffer, so recording
+ * needs no locks. Buffers are only read when exporting, after tracing stops
+ * and after writes that started before stopping have finished.
+ * Buffers are allocated on the first event a thread records while tracing,
+ * and reused by other threads after the thread exits.
+ */
+class LuaTracer : public RefCounted {
+	GDCLASS(LuaTracer, RefCounted);
+
+public:
+	// Categories for boundary crossings
+	static constexpr const char *GODOT_TO_LUA = "godot_to_lua";
+	static constexpr const char *LUA_TO_GODOT = "lua_to_godot";
+
+	// Records an event spanning the lifetime of the scope, if tracing is running
+	struct Scope {
+		Scope(const char *category, const char *label, const StringName *name = nullptr) {
+			if (running.load(std::memory_order_relaxed)) {
+				begin(category, label, name);
+			}
+		}
+		~Scope() {
+			if (category) {
+				end();
+			}
+		}
+
+	private:
+		const char *category = nullptr;
+		const char *label;
+		const StringName *name;
+		uint64_t start_nsec;
+
+		void begin(const char *category, const char *label, const StringName *name);
+		void end();
+	};
+
+	static void start(int events_per_thread = 65536);
+	static void stop();
+	static void clear();
+	static bool is_running();
+	static int get_event_count();
+	static String get_trace_json();
+	static Error save_trace(const String& path);
+
+	// Frees all thread buffers, called when the extension is unloaded
+	static void free_buffers();
+
+protected:
+	static void _bind_methods();
+
+private:
+	struct Event {
+		// Buffers may be reused by other threads, so each event stores its own thread
+		uint64_t thread_id;
+		const char *category;
+		const char *label;
+		// Index in `ThreadBuffer::names` plus one, or 0 for events without name
+		uint32_t name_id;
+		uint64_t start_nsec;
+		uint64_t duration_nsec;
+	};
+
+	struct ThreadBuffer {
+		uint64_t thread_id;
+		// Whether a running thread owns this buffer, guarded by `buffers_mutex`
+		bool in_use = true;
+		LocalVector<Event> events;
+		std::atomic<uint64_t> write_count = 0;
+		// Set while an event is being written, so that exporting waits for it
+		std::atomic<bool> writing = false;
+		// Names are stored once per thread, so that events don't hold StringName references
+		HashMap<StringName, uint32_t> name_ids;
+		LocalVector<StringName> names;
+
+		uint32_t get_name_id(const StringName& name);
+		void resize(uint64_t size);
+	};
+
+	// Releases the buffer when its thread exits
+	struct ThreadBufferOwner {
+		ThreadBuffer *buffer = nullptr;
+
+		~ThreadBufferOwner();
+	};
+
+	static ThreadBuffer *get_thread_buffer();
+	static void wait_for_writers();
+
+	static std::atomic<bool> running;
+	static int events_per_thread;
+	static LocalVector<ThreadBuffer *> buffers;
+	static thread_local ThreadBufferOwner thread_buffer;
+};
+
+}
+
+#endif  // __LUA_TRACER_HPP__
@@ -0,0 +1,294 @@
+/**
+ * Copyright (C) 2026 Gil Barbosa Reis.
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the “Software”), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ * of the Software, and to permit persons to whom the Software is furnished to do
+ * so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#include "LuaWorker.hpp"
+
+#include "LuaError.hpp"
+#include "LuaFunction.hpp"
+#include "LuaState.hpp"
+#include "LuaTable.hpp"
+#include "utils/LuaHookDispatcher.hpp"
+#include "utils/convert_godot_lua.hpp"
+
+#include <godot_cpp/variant/callable_method_pointer.hpp>
+#include <godot_cpp/variant/utility_functions.hpp>
+
+namespace luagdextension {
+
+// VM instructions between checks for `stop` requests
+static constexpr int STOP_CHECK_INSTRUCTIONS = 1000;
+
+// Nested Lua tables are converted to Dictionaries up to this depth, which also breaks cycles
+static constexpr int MAX_MESSAGE_DEPTH = 64;
+
+// Lua values are only valid in their own state, so tables are converted to plain Dictionaries
+static Variant to_message(const Variant& value, int depth = 0) {
+	ERR_FAIL_COND_V_MSG(depth > MAX_MESSAGE_DEPTH, Variant(), "Message is too deeply nested");
+	switch (value.get_type()) {
+		case Variant::OBJECT:
+			if (LuaTable *table = Object::cast_to<LuaTable>(value)) {
+				Dictionary dictionary;
+				Dictionary table_dictionary = table->to_dictionary();
+				Array keys = table_dictionary.keys();
+				for (int i = 0; i < keys.size(); i++) {
+					dictionary[to_message(keys[i], depth + 1)] = to_message(table_dictionary[keys[i]], depth + 1);
+				}
+				return dictionary;
+			}
+			ERR_FAIL_V_MSG(Variant(), "Objects cannot be sent between LuaWorker threads");
+
+		case Variant::DICTIONARY: {
+			Dictionary dictionary;
+			Dictionary original = value;
+			Array keys = original.keys();
+			for (int i = 0; i < keys.size(); i++) {
+				dictionary[to_message(keys[i], depth + 1)] = to_message(original[keys[i]], depth + 1);
+			}
+			return dictionary;
+		}
+
+		case Variant::ARRAY: {
+			Array array;
+			Array original = value;
+			for (int i = 0; i < original.size(); i++) {
+				array.append(to_message(original[i], depth + 1));
+			}
+			return array;
+		}
+
+		default:
+			return value;
+	}
+}
+
+LuaWorker::~LuaWorker() {
+	stop();
+}
+
+Error LuaWorker::start(const String& source, const String& chunkname) {
+	ERR_FAIL_COND_V_MSG(is_running(), ERR_ALREADY_IN_USE, "LuaWorker is already running");
+
+	// A previous run may have finished without its deferred callbacks being called yet
+	join_thread();
+	run_id++;
+
+	this->source = source;
+	this->chunkname = chunkname;
+	inbox.resize(queue_capacity);
+	outbox.resize(queue_capacity);
+	inbox_semaphore.instantiate();
+	stopping.store(false);
+
+	thread.instantiate();
+	return thread->start(callable_mp(this, &LuaWorker::run).bind(run_id));
+}
+
+void LuaWorker::stop() {
+	if (thread.is_null()) {
+		return;
+	}
+
+	// Lua code that is not waiting for messages is interrupted by `stop_hook`
+	stopping.store(true);
+	inbox_semaphore->post();
+	join_thread();
+}
+
+bool LuaWorker::is_running() const {
+	return thread.is_valid() && thread->is_alive();
+}
+
+bool LuaWorker::post(const Variant& message) {
+	ERR_FAIL_COND_V_MSG(!is_running(), false, "LuaWorker is not running");
+	if (!inbox.push(UtilityFunctions::var_to_bytes(to_message(message)))) {
+		return false;
+	}
+	inbox_semaphore->post();
+	return true;
+}
+
+Variant LuaWorker::poll() {
+	PackedByteArray bytes;
+	if (outbox.pop(bytes)) {
+		return UtilityFunctions::bytes_to_var(bytes);
+	}
+	else {
+		return Variant();
+	}
+}
+
+bool LuaWorker::has_messages() const {
+	return !outbox.is_empty();
+}
+
+int LuaWorker::get_queue_capacity() const {
+	return queue_capacity;
+}
+
+void LuaWorker::set_queue_capacity(int capacity) {
+	ERR_FAIL_COND_MSG(capacity <= 0, "Queue capacity must be positive");
+	queue_capacity = capacity;
+}
+
+void LuaWorker::run(uint64_t run_id) {
+	Ref<LuaState> lua_state;
+	lua_state.instantiate();
+	lua_state->open_libraries();
+	sol::state_view state = lua_state->get_lua_state();
+	register_worker_api(state);
+	// Hooks are only changed from the worker thread, `stop` just sets a flag checked by the hook.
+	// Coroutines inherit the hook from the thread that creates them.
+	LuaHookDispatcher::get(state)->add(this, stop_hook, this, LUA_MASKCOUNT, STOP_CHECK_INSTRUCTIONS);
+
+	Variant result = lua_state->do_string(source, chunkname);
+	// If the chunk returns a function, it handles every message until the worker stops
+	if (LuaFunction *handler = Object::cast_to<LuaFunction>(result)) {
+		Ref<LuaFunction> handler_ref = handler;
+		result = Variant();
+		while (!stopping.load()) {
+			PackedByteArray bytes;
+			if (!inbox.pop(bytes)) {
+				inbox_semaphore->wait();
+				continue;
+			}
+			Variant handler_result = handler_ref->invokev(Array::make(UtilityFunctions::bytes_to_var(bytes)));
+			if (Object::cast_to<LuaError>(handler_result)) {
+				result = handler_result;
+				break;
+			}
+		}
+	}
+
+	if (Object::cast_to<LuaError>(result)) {
+		// Errors caused by `stop` are expected
+		if (!stopping.load()) {
+			callable_mp(this, &LuaWorker::emit_failed).call_deferred(result, run_id);
+		}
+	}
+	else {
+		callable_mp(this, &LuaWorker::emit_finished).call_deferred(UtilityFunctions::bytes_to_var(UtilityFunctions::var_to_bytes(to_message(result))), run_id);
+	}
+}
+
+void LuaWorker::register_worker_api(sol::state_view& state) {
+	sol::table worker = state.create_table();
+	worker.set_function("post", &LuaWorker::worker_post, this);
+	worker.set_function("poll", &LuaWorker::worker_poll, this);
+	worker.set_function("wait", &LuaWorker::worker_wait, this);
+	worker.set_function("is_stopping", [this]() { return stopping.load(); });
+	state["worker"] = worker;
+}
+
+bool LuaWorker::worker_post(const sol::stack_object& value) {
+	if (!outbox.push(UtilityFunctions::var_to_bytes(to_message(to_variant(value))))) {
+		return false;
+	}
+	// Signals must be emitted in the main thread
+	if (!dispatch_pending.exchange(true)) {
+		callable_mp(this, &LuaWorker::dispatch_messages).call_deferred();
+	}
+	return true;
+}
+
+sol::object LuaWorker::worker_poll(sol::this_state state) {
+	PackedByteArray bytes;
+	if (inbox.pop(bytes)) {
+		return to_lua(state, UtilityFunctions::bytes_to_var(bytes));
+	}
+	else {
+		return sol::nil;
+	}
+}
+
+sol::object LuaWorker::worker_wait(sol::this_state state) {
+	while (!stopping.load()) {
+		PackedByteArray bytes;
+		if (inbox.pop(bytes)) {
+			return to_lua(state, UtilityFunctions::bytes_to_var(bytes));
+		}
+		inbox_semaphore->wait();
+	}
+	return sol::nil;
+}
+
+void LuaWorker::dispatch_messages() {
+	dispatch_pending.store(false);
+	// Without connections, messages stay in the queue for `poll`
+	if (get_signal_connection_list("message_received").is_empty()) {
+		return;
+	}
+	PackedByteArray bytes;
+	while (outbox.pop(bytes)) {
+		emit_signal("message_received", UtilityFunctions::bytes_to_var(bytes));
+	}
+}
+
+void LuaWorker::emit_finished(const Variant& result, uint64_t run_id) {
+	// The worker was restarted, this result belongs to a previous run
+	if (run_id != this->run_id) {
+		return;
+	}
+	// Deliver messages posted before finishing first
+	dispatch_messages();
+	join_thread();
+	emit_signal("finished", result);
+}
+
+void LuaWorker::emit_failed(const Variant& error, uint64_t run_id) {
+	if (run_id != this->run_id) {
+		return;
+	}
+	dispatch_messages();
+	join_thread();
+	emit_signal("failed", error);
+}
+
+void LuaWorker::join_thread() {
+	if (thread.is_valid() && thread->is_started()) {
+		thread->wait_to_finish();
+	}
+	thread.unref();
+}
+
+void LuaWorker::stop_hook(lua_State *L, lua_Debug *ar, void *worker) {
+	if (((LuaWorker *) worker)->stopping.load(std::memory_order_relaxed)) {
+		luaL_error(L, "LuaWorker stopped");
+	}
+}
+
+void LuaWorker::_bind_methods() {
+	ClassDB::bind_method(D_METHOD("start", "source", "chunkname"), &LuaWorker::start, DEFVAL(""));
+	ClassDB::bind_method(D_METHOD("stop"), &LuaWorker::stop);
+	ClassDB::bind_method(D_METHOD("is_running"), &LuaWorker::is_running);
+	ClassDB::bind_method(D_METHOD("post", "message"), &LuaWorker::post);
+	ClassDB::bind_method(D_METHOD("poll"), &LuaWorker::poll);
+	ClassDB::bind_method(D_METHOD("has_messages"), &LuaWorker::has_messages);
+	ClassDB::bind_method(D_METHOD("get_queue_capacity"), &LuaWorker::get_queue_capacity);
+	ClassDB::bind_method(D_METHOD("set_queue_capacity", "capacity"), &LuaWorker::set_queue_capacity);
+
+	ADD_PROPERTY(PropertyInfo(Variant::INT, "queue_capacity"), "set_queue_capacity", "get_queue_capacity");
+
+	ADD_SIGNAL(MethodInfo("message_received", PropertyInfo(Variant::NIL, "message", PROPERTY_HINT_NONE, "", PROPERTY_USAGE_NIL_IS_VARIANT)));
+	ADD_SIGNAL(MethodInfo("finished", PropertyInfo(Variant::NIL, "result", PROPERTY_HINT_NONE, "", PROPERTY_USAGE_NIL_IS_VARIANT)));
+	ADD_SIGNAL(MethodInfo("failed", PropertyInfo(Variant::OBJECT, "error", PROPERTY_HINT_NONE, "", PROPERTY_USAGE_DEFAULT, LuaError::get_class_static())));
+}
+
+}
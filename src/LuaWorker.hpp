@@ -0,0 +1,90 @@
+/**
+ * Copyright (C) 2026 Gil Barbosa Reis.
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the “Software”), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ * of the Software, and to permit persons to whom the Software is furnished to do
+ * so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#ifndef __LUA_WORKER_HPP__
+#define __LUA_WORKER_HPP__
+
+#include "utils/SPSCQueue.hpp"
+#include "utils/custom_sol.hpp"
+
+#include <atomic>
+
+#include <godot_cpp/classes/ref_counted.hpp>
+#include <godot_cpp/classes/semaphore.hpp>
+#include <godot_cpp/classes/thread.hpp>
+
+using namespace godot;
+
+namespace luagdextension {
+
+class LuaWorker : public RefCounted {
+	GDCLASS(LuaWorker, RefCounted);
+
+public:
+	virtual ~LuaWorker();
+
+	Error start(const String& source, const String& chunkname = "");
+	void stop();
+	bool is_running() const;
+
+	bool post(const Variant& message);
+	Variant poll();
+	bool has_messages() const;
+
+	int get_queue_capacity() const;
+	void set_queue_capacity(int capacity);
+
+protected:
+	static void _bind_methods();
+
+private:
+	String source;
+	String chunkname;
+	int queue_capacity = 64;
+
+	Ref<Thread> thread;
+	Ref<Semaphore> inbox_semaphore;
+	// Main thread -> worker
+	SPSCQueue<PackedByteArray> inbox;
+	// Worker -> main thread
+	SPSCQueue<PackedByteArray> outbox;
+	std::atomic<bool> stopping = false;
+	std::atomic<bool> dispatch_pending = false;
+	// Incremented by `start`, so that deferred callbacks from previous runs are ignored
+	uint64_t run_id = 0;
+
+	void run(uint64_t run_id);
+	void register_worker_api(sol::state_view& state);
+	bool worker_post(const sol::stack_object& value);
+	sol::object worker_poll(sol::this_state state);
+	sol::object worker_wait(sol::this_state state);
+
+	void dispatch_messages();
+	void emit_finished(const Variant& result, uint64_t run_id);
+	void emit_failed(const Variant& error, uint64_t run_id);
+	void join_thread();
+
+	static void stop_hook(lua_State *L, lua_Debug *ar, void *worker);
+};
+
+}
+
+#endif  // __LUA_WORKER_HPP__
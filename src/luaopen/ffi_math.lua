@@ -0,0 +1,408 @@
+-- LuaJIT FFI structs for Godot math types, loaded by `require "godot.ffi_math"`.
+-- Operations implemented here are compiled by the JIT, others fall back to Variant.
+local ffi, real_t, to_variant = ...
+
+local concat, istype, sqrt = table.concat, ffi.istype, math.sqrt
+
+ffi.cdef((([[
+typedef struct { real_t x, y; } godot_Vector2;
+typedef struct { int32_t x, y; } godot_Vector2i;
+typedef struct { real_t x, y, z; } godot_Vector3;
+typedef struct { int32_t x, y, z; } godot_Vector3i;
+typedef struct { real_t x, y, z, w; } godot_Vector4;
+typedef struct { int32_t x, y, z, w; } godot_Vector4i;
+typedef struct { float r, g, b, a; } godot_Color;
+typedef struct { real_t x, y, z, w; } godot_Quaternion;
+typedef struct { godot_Vector2 position, size; } godot_Rect2;
+typedef struct { godot_Vector3 normal; real_t d; } godot_Plane;
+typedef struct { godot_Vector3 position, size; } godot_AABB;
+typedef struct { godot_Vector3 rows[3]; } godot_Basis;
+typedef struct { godot_Vector2 columns[3]; } godot_Transform2D;
+typedef struct { godot_Basis basis; godot_Vector3 origin; } godot_Transform3D;
+]]):gsub("real_t", real_t)))
+
+local Vector2 = ffi.typeof("godot_Vector2")
+local Vector2i = ffi.typeof("godot_Vector2i")
+local Vector3 = ffi.typeof("godot_Vector3")
+local Vector3i = ffi.typeof("godot_Vector3i")
+local Vector4 = ffi.typeof("godot_Vector4")
+local Vector4i = ffi.typeof("godot_Vector4i")
+local Color = ffi.typeof("godot_Color")
+local Quaternion = ffi.typeof("godot_Quaternion")
+local Rect2 = ffi.typeof("godot_Rect2")
+local Plane = ffi.typeof("godot_Plane")
+local AABB = ffi.typeof("godot_AABB")
+local Basis = ffi.typeof("godot_Basis")
+local Transform2D = ffi.typeof("godot_Transform2D")
+local Transform3D = ffi.typeof("godot_Transform3D")
+
+-- Members not implemented in Lua, like most methods, are accessed through a Variant copy
+local function variant_index(methods)
+	return function(self, key)
+		local method = methods[key]
+		if method ~= nil then
+			return method
+		end
+		return to_variant(self)[key]
+	end
+end
+
+local function variant_tostring(self)
+	return tostring(to_variant(self))
+end
+
+-- Generates straight-line code for component-wise vector operations
+local function expand(fields, pattern, separator)
+	local parts = {}
+	for i, field in ipairs(fields) do
+		parts[i] = pattern:gsub("%$", field)
+	end
+	return concat(parts, separator)
+end
+
+local VECTOR_TEMPLATE = [[
+local T, istype, to_variant, sqrt, is_integer = ...
+local mt = {}
+local methods = {}
+
+local function is_scalar(value)
+	return type(value) == "number" and (not is_integer or value % 1 == 0)
+end
+
+function mt.__add(a, b)
+	if istype(T, a) and istype(T, b) then
+		return T(${a.$ + b.$})
+	end
+	return to_variant(a) + to_variant(b)
+end
+
+function mt.__sub(a, b)
+	if istype(T, a) and istype(T, b) then
+		return T(${a.$ - b.$})
+	end
+	return to_variant(a) - to_variant(b)
+end
+
+function mt.__mul(a, b)
+	if istype(T, a) then
+		if istype(T, b) then
+			return T(${a.$ * b.$})
+		elseif is_scalar(b) then
+			return T(${a.$ * b})
+		end
+	elseif is_scalar(a) and istype(T, b) then
+		return T(${a * b.$})
+	end
+	return to_variant(a) * to_variant(b)
+end
+
+function mt.__div(a, b)
+	if istype(T, a) and not is_integer then
+		if istype(T, b) then
+			return T(${a.$ / b.$})
+		elseif type(b) == "number" then
+			return T(${a.$ / b})
+		end
+	end
+	return to_variant(a) / to_variant(b)
+end
+
+function mt.__unm(a)
+	return T(${-a.$})
+end
+
+function mt.__eq(a, b)
+	return istype(T, a) and istype(T, b) and ${a.$ == b.$|and}
+end
+
+function methods.dot(a, b)
+	return ${a.$ * b.$|+}
+end
+
+function methods.length_squared(a)
+	return ${a.$ * a.$|+}
+end
+
+function methods.length(a)
+	return sqrt(${a.$ * a.$|+})
+end
+
+function methods.distance_squared_to(a, b)
+	return ${(b.$ - a.$) * (b.$ - a.$)|+}
+end
+
+function methods.distance_to(a, b)
+	return sqrt(${(b.$ - a.$) * (b.$ - a.$)|+})
+end
+
+function methods.normalized(a)
+	local length = sqrt(${a.$ * a.$|+})
+	if length == 0 then
+		return T()
+	end
+	return T(${a.$ / length})
+end
+
+function methods.lerp(a, b, weight)
+	return T(${a.$ + (b.$ - a.$) * weight})
+end
+
+return mt, methods
+]]
+
+local function define_vector(T, fields, is_integer)
+	local source = VECTOR_TEMPLATE:gsub("%${([^}|]*)|?([^}]*)}", function(pattern, separator)
+		if separator == "" then
+			return expand(fields, pattern, ", ")
+		else
+			return expand(fields, pattern, " " .. separator .. " ")
+		end
+	end)
+	local mt, methods = assert(loadstring(source, "=ffi_math"))(T, istype, to_variant, sqrt, is_integer)
+	mt.__index = variant_index(methods)
+	mt.__tostring = variant_tostring
+	return mt, methods
+end
+
+local Vector2_mt, Vector2_methods = define_vector(Vector2, { "x", "y" })
+local Vector2i_mt = define_vector(Vector2i, { "x", "y" }, true)
+local Vector3_mt, Vector3_methods = define_vector(Vector3, { "x", "y", "z" })
+local Vector3i_mt = define_vector(Vector3i, { "x", "y", "z" }, true)
+local Vector4_mt = define_vector(Vector4, { "x", "y", "z", "w" })
+local Vector4i_mt = define_vector(Vector4i, { "x", "y", "z", "w" }, true)
+local Color_mt = define_vector(Color, { "r", "g", "b", "a" })
+
+function Vector2_methods.cross(a, b)
+	return a.x * b.y - a.y * b.x
+end
+
+function Vector3_methods.cross(a, b)
+	return Vector3(
+		a.y * b.z - a.z * b.y,
+		a.z * b.x - a.x * b.z,
+		a.x * b.y - a.y * b.x
+	)
+end
+
+-- Quaternion
+local Quaternion_methods = {}
+local Quaternion_mt = {
+	__index = variant_index(Quaternion_methods),
+	__tostring = variant_tostring,
+}
+
+function Quaternion_mt.__mul(a, b)
+	if istype(Quaternion, a) then
+		if istype(Quaternion, b) then
+			return Quaternion(
+				a.w * b.x + a.x * b.w + a.y * b.z - a.z * b.y,
+				a.w * b.y + a.y * b.w + a.z * b.x - a.x * b.z,
+				a.w * b.z + a.z * b.w + a.x * b.y - a.y * b.x,
+				a.w * b.w - a.x * b.x - a.y * b.y - a.z * b.z
+			)
+		elseif istype(Vector3, b) then
+			-- v + 2w(u x v) + 2u x (u x v)
+			local cx = a.y * b.z - a.z * b.y
+			local cy = a.z * b.x - a.x * b.z
+			local cz = a.x * b.y - a.y * b.x
+			return Vector3(
+				b.x + 2 * (a.w * cx + a.y * cz - a.z * cy),
+				b.y + 2 * (a.w * cy + a.z * cx - a.x * cz),
+				b.z + 2 * (a.w * cz + a.x * cy - a.y * cx)
+			)
+		end
+	end
+	return to_variant(a) * to_variant(b)
+end
+
+function Quaternion_mt.__eq(a, b)
+	return istype(Quaternion, a) and istype(Quaternion, b) and a.x == b.x and a.y == b.y and a.z == b.z and a.w == b.w
+end
+
+function Quaternion_methods.inverse(q)
+	return Quaternion(-q.x, -q.y, -q.z, q.w)
+end
+
+-- Basis
+local Basis_methods = {}
+local Basis_mt = {
+	__index = variant_index(Basis_methods),
+	__tostring = variant_tostring,
+}
+
+local function basis_xform(m, v)
+	local r0, r1, r2 = m.rows[0], m.rows[1], m.rows[2]
+	return Vector3(
+		r0.x * v.x + r0.y * v.y + r0.z * v.z,
+		r1.x * v.x + r1.y * v.y + r1.z * v.z,
+		r2.x * v.x + r2.y * v.y + r2.z * v.z
+	)
+end
+
+local function basis_mul(a, b)
+	local a0, a1, a2 = a.rows[0], a.rows[1], a.rows[2]
+	local b0, b1, b2 = b.rows[0], b.rows[1], b.rows[2]
+	return Basis({ rows = {
+		{ a0.x * b0.x + a0.y * b1.x + a0.z * b2.x, a0.x * b0.y + a0.y * b1.y + a0.z * b2.y, a0.x * b0.z + a0.y * b1.z + a0.z * b2.z },
+		{ a1.x * b0.x + a1.y * b1.x + a1.z * b2.x, a1.x * b0.y + a1.y * b1.y + a1.z * b2.y, a1.x * b0.z + a1.y * b1.z + a1.z * b2.z },
+		{ a2.x * b0.x + a2.y * b1.x + a2.z * b2.x, a2.x * b0.y + a2.y * b1.y + a2.z * b2.y, a2.x * b0.z + a2.y * b1.z + a2.z * b2.z },
+	} })
+end
+
+local function basis_inverse(m)
+	local r0, r1, r2 = m.rows[0], m.rows[1], m.rows[2]
+	local co0 = r1.y * r2.z - r1.z * r2.y
+	local co1 = r1.z * r2.x - r1.x * r2.z
+	local co2 = r1.x * r2.y - r1.y * r2.x
+	local s = 1 / (r0.x * co0 + r0.y * co1 + r0.z * co2)
+	return Basis({ rows = {
+		{ co0 * s, (r0.z * r2.y - r0.y * r2.z) * s, (r0.y * r1.z - r0.z * r1.y) * s },
+		{ co1 * s, (r0.x * r2.z - r0.z * r2.x) * s, (r0.z * r1.x - r0.x * r1.z) * s },
+		{ co2 * s, (r0.y * r2.x - r0.x * r2.y) * s, (r0.x * r1.y - r0.y * r1.x) * s },
+	} })
+end
+
+function Basis_mt.__mul(a, b)
+	if istype(Basis, a) then
+		if istype(Vector3, b) then
+			return basis_xform(a, b)
+		elseif istype(Basis, b) then
+			return basis_mul(a, b)
+		end
+	end
+	return to_variant(a) * to_variant(b)
+end
+
+function Basis_mt.__eq(a, b)
+	return istype(Basis, a) and istype(Basis, b)
+		and a.rows[0] == b.rows[0] and a.rows[1] == b.rows[1] and a.rows[2] == b.rows[2]
+end
+
+Basis_methods.inverse = basis_inverse
+
+function Basis_methods.transposed(m)
+	local r0, r1, r2 = m.rows[0], m.rows[1], m.rows[2]
+	return Basis({ rows = { { r0.x, r1.x, r2.x }, { r0.y, r1.y, r2.y }, { r0.z, r1.z, r2.z } } })
+end
+
+-- Transform2D
+local Transform2D_methods = {}
+local Transform2D_mt = {
+	__index = variant_index(Transform2D_methods),
+	__tostring = variant_tostring,
+}
+
+local function transform2d_xform(t, v)
+	local x, y, o = t.columns[0], t.columns[1], t.columns[2]
+	return Vector2(x.x * v.x + y.x * v.y + o.x, x.y * v.x + y.y * v.y + o.y)
+end
+
+function Transform2D_mt.__mul(a, b)
+	if istype(Transform2D, a) then
+		if istype(Vector2, b) then
+			return transform2d_xform(a, b)
+		elseif istype(Transform2D, b) then
+			local x, y = a.columns[0], a.columns[1]
+			local bx, by = b.columns[0], b.columns[1]
+			return Transform2D({ columns = {
+				{ x.x * bx.x + y.x * bx.y, x.y * bx.x + y.y * bx.y },
+				{ x.x * by.x + y.x * by.y, x.y * by.x + y.y * by.y },
+				transform2d_xform(a, b.columns[2]),
+			} })
+		end
+	end
+	return to_variant(a) * to_variant(b)
+end
+
+function Transform2D_mt.__eq(a, b)
+	return istype(Transform2D, a) and istype(Transform2D, b)
+		and a.columns[0] == b.columns[0] and a.columns[1] == b.columns[1] and a.columns[2] == b.columns[2]
+end
+
+-- Transform3D
+local Transform3D_methods = {}
+local Transform3D_mt = {
+	__index = variant_index(Transform3D_methods),
+	__tostring = variant_tostring,
+}
+
+function Transform3D_mt.__mul(a, b)
+	if istype(Transform3D, a) then
+		if istype(Vector3, b) then
+			local v = basis_xform(a.basis, b)
+			return Vector3(v.x + a.origin.x, v.y + a.origin.y, v.z + a.origin.z)
+		elseif istype(Transform3D, b) then
+			local origin = basis_xform(a.basis, b.origin)
+			return Transform3D(basis_mul(a.basis, b.basis), { origin.x + a.origin.x, origin.y + a.origin.y, origin.z + a.origin.z })
+		end
+	end
+	return to_variant(a) * to_variant(b)
+end
+
+function Transform3D_mt.__eq(a, b)
+	return istype(Transform3D, a) and istype(Transform3D, b) and a.basis == b.basis and a.origin == b.origin
+end
+
+function Transform3D_methods.affine_inverse(t)
+	local basis = basis_inverse(t.basis)
+	local origin = basis_xform(basis, t.origin)
+	return Transform3D(basis, { -origin.x, -origin.y, -origin.z })
+end
+
+-- Types without Lua implemented operations
+local function variant_only()
+	return {
+		__index = function(self, key) return to_variant(self)[key] end,
+		__tostring = variant_tostring,
+		__eq = function(a, b) return to_variant(a) == to_variant(b) end,
+	}
+end
+
+-- Variant.Type values, used to convert between cdata and Variant
+local VECTOR2, VECTOR2I, RECT2, VECTOR3, VECTOR3I, TRANSFORM2D, VECTOR4, VECTOR4I, PLANE, QUATERNION, AABB, BASIS, TRANSFORM3D, COLOR =
+	5, 6, 7, 9, 10, 11, 12, 13, 14, 15, 16, 17, 18, 20
+
+local ctypes = {
+	[VECTOR2] = ffi.metatype(Vector2, Vector2_mt),
+	[VECTOR2I] = ffi.metatype(Vector2i, Vector2i_mt),
+	[RECT2] = ffi.metatype(Rect2, variant_only()),
+	[VECTOR3] = ffi.metatype(Vector3, Vector3_mt),
+	[VECTOR3I] = ffi.metatype(Vector3i, Vector3i_mt),
+	[TRANSFORM2D] = ffi.metatype(Transform2D, Transform2D_mt),
+	[VECTOR4] = ffi.metatype(Vector4, Vector4_mt),
+	[VECTOR4I] = ffi.metatype(Vector4i, Vector4i_mt),
+	[PLANE] = ffi.metatype(Plane, variant_only()),
+	[QUATERNION] = ffi.metatype(Quaternion, Quaternion_mt),
+	[AABB] = ffi.metatype(AABB, variant_only()),
+	[BASIS] = ffi.metatype(Basis, Basis_mt),
+	[TRANSFORM3D] = ffi.metatype(Transform3D, Transform3D_mt),
+	[COLOR] = ffi.metatype(Color, Color_mt),
+}
+
+local variant_types = {}
+for variant_type, ctype in pairs(ctypes) do
+	variant_types[tonumber(ctype)] = variant_type
+end
+
+return {
+	module = {
+		Vector2 = Vector2,
+		Vector2i = Vector2i,
+		Vector3 = Vector3,
+		Vector3i = Vector3i,
+		Vector4 = Vector4,
+		Vector4i = Vector4i,
+		Color = Color,
+		Quaternion = Quaternion,
+		Rect2 = Rect2,
+		Plane = Plane,
+		AABB = AABB,
+		Basis = Basis,
+		Transform2D = Transform2D,
+		Transform3D = Transform3D,
+	},
+	ctypes = ctypes,
+	variant_type_of = function(value)
+		return variant_types[tonumber(ffi.typeof(value))]
+	end,
+}
@@ -0,0 +1,36 @@
+-- Scoped LuaJIT FFI views of Packed array memory, used by `Variant.ffi_view`
+local ffi, packed_array_pointer, release_pin = ...
+
+local view_types = {}
+local pointer_types = {}
+
+local function get_types(ctype)
+	local view_type = view_types[ctype]
+	if not view_type then
+		view_type = ffi.typeof("struct { " .. ctype .. " *data; int64_t size; }")
+		view_types[ctype] = view_type
+		pointer_types[ctype] = ffi.typeof(ctype .. " *")
+	end
+	return view_type, pointer_types[ctype]
+end
+
+return function(array, callback)
+	-- `pin` shares the viewed buffer, so resizing or modifying `array` copies it instead of freeing the viewed memory
+	local pointer, size, ctype, pin = packed_array_pointer(array, true)
+	local view_type, pointer_type = get_types(ctype)
+	local view = view_type(ffi.cast(pointer_type, pointer), size)
+	local ok, result = pcall(callback, view)
+	-- Invalidate the view, in case the callback kept a reference to it
+	view.data = nil
+	view.size = 0
+	-- Compare before releasing the pin, so that a new buffer cannot reuse the viewed address
+	local new_pointer, new_size = packed_array_pointer(array, false)
+	release_pin(pin)
+	if not ok then
+		error(result, 0)
+	end
+	if new_pointer ~= pointer or new_size ~= size then
+		error("Packed array was resized or modified while its FFI view was in use, writes to the view were discarded", 2)
+	end
+	return result
+end
@@ -27,9 +27,13 @@
 #include "../utils/string_names.hpp"
 #include "../LuaCoroutine.hpp"
 #include "../LuaObject.hpp"
+#include "../LuaTracer.hpp"
+
+#include <atomic>
 
 #include <godot_cpp/core/error_macros.hpp>
 #include <godot_cpp/classes/object.hpp>
+#include <godot_cpp/templates/hashfuncs.hpp>
 #include <godot_cpp/variant/utility_functions.hpp>
 
 using namespace godot;
@@ -53,23 +57,41 @@ template<typename RetType, StringLiteral func_name, size_t func_hash> sol::objec
 struct ResumeLuaCoroutineCallable : public CallableCustom {
 	ResumeLuaCoroutineCallable(lua_State *L)
 		: coroutine(LuaObject::wrap_object<LuaCoroutine>(sol::thread(L, L)))
+		, await_id(await_count.fetch_add(1, std::memory_order_relaxed))
 	{
 	}
 
 	uint32_t hash() const override {
-		return get_as_text().hash();
+		return hash_murmur3_one_64(await_id, hash_one_uint64((uint64_t) coroutine.ptr()));
 	}
 
 	String get_as_text() const override {
 		return "<ResumeLuaCoroutineCallable>";
 	}
 
+	// Each `await` creates a distinct Callable, so that awaiting the same signal again while it is being emitted,
+	// before the one shot connection is removed, connects again instead of being considered a duplicate
+	static bool compare_equal(const CallableCustom *a, const CallableCustom *b) {
+		const ResumeLuaCoroutineCallable *callable_a = (const ResumeLuaCoroutineCallable *) a;
+		const ResumeLuaCoroutineCallable *callable_b = (const ResumeLuaCoroutineCallable *) b;
+		return callable_a->coroutine == callable_b->coroutine && callable_a->await_id == callable_b->await_id;
+	}
+
+	static bool compare_less(const CallableCustom *a, const CallableCustom *b) {
+		const ResumeLuaCoroutineCallable *callable_a = (const ResumeLuaCoroutineCallable *) a;
+		const ResumeLuaCoroutineCallable *callable_b = (const ResumeLuaCoroutineCallable *) b;
+		if (callable_a->coroutine != callable_b->coroutine) {
+			return callable_a->coroutine.ptr() < callable_b->coroutine.ptr();
+		}
+		return callable_a->await_id < callable_b->await_id;
+	}
+
 	CompareEqualFunc get_compare_equal_func() const override {
-		return nullptr;
+		return compare_equal;
 	}
 
 	CompareLessFunc get_compare_less_func() const override {
-		return nullptr;
+		return compare_less;
 	}
 
 	bool is_valid() const override {
@@ -82,10 +104,14 @@ struct ResumeLuaCoroutineCallable : public CallableCustom {
 	}
 
 	void call(const Variant **p_arguments, int p_argcount, Variant &r_return_value, GDExtensionCallError &r_call_error) const override {
+		LuaTracer::Scope trace_scope(LuaTracer::GODOT_TO_LUA, "await");
 		r_return_value = coroutine->resume(p_arguments, p_argcount, r_call_error);
 	}
 
 	Ref<LuaCoroutine> coroutine;
+	uint64_t await_id;
+
+	static inline std::atomic<uint64_t> await_count = 0;
 };
 
 static int lua_await(lua_State *L) {
@@ -32,12 +32,21 @@
 #include "../utils/ObjectIterator.hpp"
 #include "../utils/VariantArguments.hpp"
 #include "../utils/VariantType.hpp"
+#include "../utils/builtin_method_binds.hpp"
 #include "../utils/convert_godot_lua.hpp"
 #include "../utils/convert_godot_std.hpp"
+#include "../utils/extra_utility_functions.hpp"
 #include "../utils/function_wrapper.hpp"
 #include "../utils/method_bind_impl.hpp"
+#include "../utils/object_method_binds.hpp"
 #include "../utils/string_names.hpp"
 
+#ifdef LUAJIT
+#include "../generated/ffi_views.h"
+#include "../utils/ffi_math.hpp"
+#include <gdextension_interface.h>
+#endif
+
 using namespace godot;
 
 namespace luagdextension {
@@ -101,7 +110,24 @@ sol::object variant__index(sol::this_state state, const Variant& variant, const
 		if (Variant::has_member(variant.get_type(), string_name)) {
 			return to_lua(state, variant.get_named(string_name, is_valid));
 		}
-		else if (variant.has_method(string_name)) {
+		if (BuiltinMethodFunc builtin_method = get_builtin_method_bind(variant.get_type(), string_name)) {
+			return sol::make_object(state, VariantMethodBind(variant, string_name, builtin_method));
+		}
+		if (variant.get_type() == Variant::OBJECT && is_instance_valid(variant)) {
+			ObjectMember member = get_object_member(variant, string_name);
+			// Engine methods are called directly with a cached MethodBind
+			if (member.method_bind) {
+				return sol::make_object(state, VariantMethodBind(variant, string_name, member.method_bind));
+			}
+			// Engine properties are read directly with their cached getter
+			if (member.property.getter) {
+				Variant result;
+				if (object_property_get(variant, string_name, member.property, result)) {
+					return to_lua(state, result);
+				}
+			}
+		}
+		if (variant.has_method(string_name)) {
 			return sol::make_object(state, VariantMethodBind(variant, string_name));
 		}
 	}
@@ -114,6 +140,14 @@ void variant__newindex(sol::this_state state, Variant& variant, const sol::stack
 	bool is_valid;
 	Variant var_key = to_variant(key);
 	Variant var_value = to_variant(value);
+	if (variant.get_type() == Variant::OBJECT && var_key.get_type() == Variant::STRING && is_instance_valid(variant)) {
+		// Engine properties are written directly with their cached setter
+		StringName property = var_key;
+		ObjectMember member = get_object_member(variant, property);
+		if (member.property.setter && object_property_set(variant, property, member.property, var_value)) {
+			return;
+		}
+	}
 	variant.set(var_key, var_value, &is_valid);
 	if (!is_valid) {
 		CharString key_str = var_key.stringify().utf8();
@@ -187,6 +221,104 @@ void variant__close(Variant& variant) {
 	variant.clear();
 }
 
+#ifdef LUAJIT
+static const char FFI_VIEW_KEY[] = "_GDEXTENSION_FFI_VIEW";
+
+#ifdef REAL_T_IS_DOUBLE
+	#define REAL_T_CTYPE "double"
+#else
+	#define REAL_T_CTYPE "float"
+#endif
+
+// Returns the Packed array stored inside `variant`, so that writes are visible to the Lua value
+template<typename T>
+static T *get_internal_packed_array(Variant& variant) {
+	static GDExtensionVariantGetInternalPtrFunc getter = gdextension_interface::get_variant_get_internal_ptr_func((GDExtensionVariantType) GetTypeInfo<T>::VARIANT_TYPE);
+	return (T *) getter(variant._native_ptr());
+}
+
+using PackedArrayPointer = std::tuple<sol::lightuserdata_value, int64_t, const char *, Variant>;
+
+template<typename T>
+static PackedArrayPointer packed_array_pointer(Variant& variant, bool pin, const char *ctype, int components = 1) {
+	T *array = get_internal_packed_array<T>(variant);
+	if (!pin) {
+		return { sol::lightuserdata_value((void *) array->ptr()), array->size() * components, ctype, Variant() };
+	}
+	// `ptrw` detaches copy-on-write buffers shared with other arrays.
+	// The copy shares the buffer afterwards, so it stays alive even if `array` is resized.
+	void *pointer = array->ptrw();
+	return { sol::lightuserdata_value(pointer), array->size() * components, ctype, T(*array) };
+}
+
+static PackedArrayPointer variant_packed_array_pointer(sol::this_state state, Variant& variant, bool pin) {
+	switch (variant.get_type()) {
+		case Variant::PACKED_BYTE_ARRAY:
+			return packed_array_pointer<PackedByteArray>(variant, pin, "uint8_t");
+
+		case Variant::PACKED_INT32_ARRAY:
+			return packed_array_pointer<PackedInt32Array>(variant, pin, "int32_t");
+
+		case Variant::PACKED_INT64_ARRAY:
+			return packed_array_pointer<PackedInt64Array>(variant, pin, "int64_t");
+
+		case Variant::PACKED_FLOAT32_ARRAY:
+			return packed_array_pointer<PackedFloat32Array>(variant, pin, "float");
+
+		case Variant::PACKED_FLOAT64_ARRAY:
+			return packed_array_pointer<PackedFloat64Array>(variant, pin, "double");
+
+		case Variant::PACKED_VECTOR2_ARRAY:
+			return packed_array_pointer<PackedVector2Array>(variant, pin, REAL_T_CTYPE, 2);
+
+		case Variant::PACKED_VECTOR3_ARRAY:
+			return packed_array_pointer<PackedVector3Array>(variant, pin, REAL_T_CTYPE, 3);
+
+		case Variant::PACKED_VECTOR4_ARRAY:
+			return packed_array_pointer<PackedVector4Array>(variant, pin, REAL_T_CTYPE, 4);
+
+		case Variant::PACKED_COLOR_ARRAY:
+			return packed_array_pointer<PackedColorArray>(variant, pin, "float", 4);
+
+		default: {
+			CharString type_str = get_type_name(variant).ascii();
+			luaL_error(state, "FFI views are not supported for %s", type_str.get_data());
+			return {};
+		}
+	}
+}
+
+static void variant_release_pin(Variant& pin) {
+	pin.clear();
+}
+
+// `Variant.ffi_view` is loaded on first use, so that it works even if the FFI library is opened after Godot's libraries
+static int l_ffi_view(lua_State *L) {
+	lua_getfield(L, LUA_REGISTRYINDEX, FFI_VIEW_KEY);
+	if (lua_isnil(L, -1)) {
+		lua_pop(L, 1);
+		lua_getfield(L, LUA_REGISTRYINDEX, "_LOADED");
+		lua_getfield(L, -1, "ffi");
+		lua_remove(L, -2);
+		if (lua_isnil(L, -1)) {
+			return luaL_error(L, "Variant.ffi_view requires the FFI library");
+		}
+		if (luaL_loadbuffer(L, ffi_views_lua, sizeof(ffi_views_lua) - 1, "=ffi_views") != LUA_OK) {
+			return lua_error(L);
+		}
+		lua_insert(L, -2);
+		sol::stack::push(L, &variant_packed_array_pointer);
+		sol::stack::push(L, &variant_release_pin);
+		lua_call(L, 3, 1);
+		lua_pushvalue(L, -1);
+		lua_setfield(L, LUA_REGISTRYINDEX, FFI_VIEW_KEY);
+	}
+	lua_insert(L, 1);
+	lua_call(L, lua_gettop(L) - 1, LUA_MULTRET);
+	return lua_gettop(L);
+}
+#endif
+
 }
 
 using namespace luagdextension;
@@ -194,7 +326,7 @@ using namespace luagdextension;
 extern "C" int luaopen_godot_variant(lua_State *L) {
 	sol::state_view state = L;
 
-	state.new_usertype<Variant>(
+	sol::usertype<Variant> variant_type = state.new_usertype<Variant>(
 		"Variant",
 		sol::call_constructor, sol::constructors<
 			Variant(),
@@ -250,6 +382,10 @@ extern "C" int luaopen_godot_variant(lua_State *L) {
 
 	VariantMethodBind::register_usertype(state);
 	VariantType::register_usertype(state);
+#ifdef LUAJIT
+	variant_type.set("ffi_view", &l_ffi_view);
+	register_ffi_math(L);
+#endif
 
 	state.set("typeof", &variant_get_type);
 
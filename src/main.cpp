@@ -19,6 +19,7 @@
  * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
  * SOFTWARE.
  */
+#include "LuaAllocationProfiler.hpp"
 #include "LuaCoroutine.hpp"
 #include "LuaDebug.hpp"
 #include "LuaError.hpp"
@@ -29,10 +30,14 @@
 #include "LuaASTNode.hpp"
 #include "LuaASTQuery.hpp"
 #include "LuaObject.hpp"
+#include "LuaSamplingProfiler.hpp"
 #include "LuaState.hpp"
+#include "LuaStatePool.hpp"
 #include "LuaTable.hpp"
 #include "LuaThread.hpp"
+#include "LuaTracer.hpp"
 #include "LuaUserdata.hpp"
+#include "LuaWorker.hpp"
 #include "script-language/LuaCodeEdit.hpp"
 #include "script-language/LuaScript.hpp"
 #include "script-language/LuaScriptImportBehaviorManager.hpp"
@@ -40,6 +45,9 @@
 #include "script-language/LuaScriptResourceFormatLoader.hpp"
 #include "script-language/LuaScriptResourceFormatSaver.hpp"
 #include "script-language/LuaSyntaxHighlighter.hpp"
+#include "utils/builtin_method_binds.hpp"
+#include "utils/object_method_binds.hpp"
+#include "utils/parallel_map.hpp"
 #include "utils/project_settings.hpp"
 #include "utils/string_names.hpp"
 
@@ -71,6 +79,11 @@ static void initialize(ModuleInitializationLevel level) {
 	ClassDB::register_abstract_class<LuaDebug>();
 	ClassDB::register_class<LuaError>();
 	ClassDB::register_class<LuaState>();
+	ClassDB::register_class<LuaStatePool>();
+	ClassDB::register_class<LuaSamplingProfiler>();
+	ClassDB::register_class<LuaAllocationProfiler>();
+	ClassDB::register_abstract_class<LuaTracer>();
+	ClassDB::register_class<LuaWorker>();
 
 	// Parser stuff
 	ClassDB::register_abstract_class<LuaASTNode>();
@@ -106,6 +119,11 @@ static void deinitialize(ModuleInitializationLevel level) {
 	LuaScriptLanguage::delete_singleton();
 	LuaScriptImportBehaviorManager::delete_singleton();
 
+	LuaTracer::free_buffers();
+	free_parallel_map_workers();
+	clear_object_method_binds();
+	free_builtin_method_binds();
+
 	memdelete(string_names);
 }
 
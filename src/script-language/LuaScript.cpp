@@ -55,6 +55,9 @@ LuaScript::LuaScript()
 
 LuaScript::~LuaScript() {
 	placeholders.erase(this);
+	if (LuaScriptLanguage *language = LuaScriptLanguage::get_singleton()) {
+		language->script_freed(this);
+	}
 }
 
 bool LuaScript::_editor_can_reload_from_file() {
@@ -155,6 +158,9 @@ Error LuaScript::_reload(bool keep_state) {
 		placeholder_fallback_enabled = false;
 		metadata.clear();
 		metadata.setup(table->get_table());
+		std::lock_guard lock(loaded_source_code_mutex);
+		loaded_source_code = source_code;
+		metadata_version.store(++next_metadata_version, std::memory_order_release);
 	}
 	return OK;
 }
@@ -310,9 +316,23 @@ Variant LuaScript::_new(const Variant **args, GDExtensionInt arg_count, GDExtens
 }
 
 const LuaScriptMetadata& LuaScript::get_metadata() const {
+	// Scripts called from other threads, like Nodes in thread groups, use metadata loaded in the thread's own LuaState
+	if (const LuaScriptMetadata *thread_metadata = LuaScriptLanguage::get_singleton()->get_thread_metadata(this)) {
+		return *thread_metadata;
+	}
 	return metadata;
 }
 
+uint64_t LuaScript::get_metadata_version() const {
+	return metadata_version.load(std::memory_order_acquire);
+}
+
+String LuaScript::get_loaded_source_code(uint64_t& version) const {
+	std::lock_guard lock(loaded_source_code_mutex);
+	version = metadata_version.load(std::memory_order_relaxed);
+	return loaded_source_code;
+}
+
 LuaScript::ImportBehavior LuaScript::get_import_behavior() const {
 	return (ImportBehavior) LuaScriptImportBehaviorManager::get_singleton()->get_script_import_behavior(get_path());
 }
@@ -363,13 +383,14 @@ GDExtensionScriptInstancePtr LuaScript::_internal_instance_create(Object *for_ob
 	LuaScriptInstance *lua_script_instance = memnew(LuaScriptInstance(for_object, Ref<LuaScript>(this)));
 	GDExtensionScriptInstancePtr gd_script_instance = gdextension_interface::script_instance_create3(LuaScriptInstance::get_script_instance_info(), lua_script_instance);
 	gdextension_interface::object_set_script_instance(for_object->_owner, gd_script_instance);
-	if (const LuaScriptMethod *_init = metadata.methods.getptr(string_names->_init)) {
+	if (const LuaScriptMethod *_init = get_metadata().methods.getptr(string_names->_init)) {
 		LuaCoroutine::invoke_lua(_init->method, VariantArguments(for_object, args, arg_count), false);
 	}
 	return gd_script_instance;
 }
 
 HashMap<const LuaScript *, HashSet<void *>> LuaScript::placeholders;
+std::atomic<uint64_t> LuaScript::next_metadata_version = 0;
 
 }
 
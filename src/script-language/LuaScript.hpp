@@ -22,6 +22,9 @@
 #ifndef __LUA_SCRIPT_EXTENSION_HPP__
 #define __LUA_SCRIPT_EXTENSION_HPP__
 
+#include <atomic>
+#include <mutex>
+
 #include <godot_cpp/classes/script_extension.hpp>
 #include <godot_cpp/templates/hash_map.hpp>
 #include <godot_cpp/templates/hash_set.hpp>
@@ -90,6 +93,9 @@ public:
 	// Script methods
 	Variant _new(const Variant **args, GDExtensionInt arg_count, GDExtensionCallError &error);
 	const LuaScriptMetadata& get_metadata() const;
+	// Version and source code of the last successful load, safe to call from any thread
+	uint64_t get_metadata_version() const;
+	String get_loaded_source_code(uint64_t& version) const;
 
 	ImportBehavior get_import_behavior() const;
 	void set_import_behavior(ImportBehavior import_behavior);
@@ -103,8 +109,15 @@ protected:
 
 	String source_code;
 	LuaScriptMetadata metadata;
+	// Changes every time metadata is set up, so that other threads know when to reload the script
+	std::atomic<uint64_t> metadata_version = 0;
+	// Source code used by other threads to load the script, guarded by `loaded_source_code_mutex`
+	String loaded_source_code;
+	mutable std::mutex loaded_source_code_mutex;
 	bool placeholder_fallback_enabled;
 
+	static std::atomic<uint64_t> next_metadata_version;
+
 	// TODO: use instance member instead of static map if "_placeholder_instance_create" is changed to be non-const
 	static HashMap<const LuaScript *, HashSet<void *>> placeholders;
 
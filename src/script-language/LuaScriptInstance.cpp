@@ -26,10 +26,12 @@
 #include "LuaScript.hpp"
 #include "LuaScriptLanguage.hpp"
 #include "LuaScriptMetadata.hpp"
+#include "LuaScriptProfiler.hpp"
 #include "LuaScriptProperty.hpp"
 #include "../LuaCoroutine.hpp"
 #include "../LuaError.hpp"
 #include "../LuaFunction.hpp"
+#include "../LuaTracer.hpp"
 #include "../utils/VariantArguments.hpp"
 #include "../utils/function_wrapper.hpp"
 #include "../utils/method_bind_impl.hpp"
@@ -120,7 +122,10 @@ LuaScriptInstance::LuaScriptInstance(Object *owner, Ref<LuaScript> script)
 	: owner(owner)
 	, script(script)
 {
-	owner_to_instance.insert(owner, this);
+	{
+		std::unique_lock lock(owner_to_instance_mutex);
+		owner_to_instance.insert(owner, this);
+	}
 
 	const LuaScriptMetadata& metadata = script->get_metadata();
 	for (auto [name, signal] : metadata.signals) {
@@ -129,6 +134,7 @@ LuaScriptInstance::LuaScriptInstance(Object *owner, Ref<LuaScript> script)
 }
 
 LuaScriptInstance::~LuaScriptInstance() {
+	std::unique_lock lock(owner_to_instance_mutex);
 	owner_to_instance.erase(owner);
 }
 
@@ -294,6 +300,8 @@ GDExtensionInt get_method_argument_count_func(LuaScriptInstance *p_instance, con
 void call_func(LuaScriptInstance *p_instance, const StringName *p_method, const Variant **p_args, GDExtensionInt p_argument_count, Variant *r_return, GDExtensionCallError *r_error) {
 	if (const LuaScriptMethod *method = p_instance->script->get_metadata().methods.getptr(*p_method)) {
 		r_error->error = GDEXTENSION_CALL_OK;
+		LuaScriptProfiler::CallScope profiler_scope(p_instance, method);
+		LuaTracer::Scope trace_scope(LuaTracer::GODOT_TO_LUA, "call_func", p_method);
 		*r_return = LuaCoroutine::invoke_lua(method->method, VariantArguments(p_instance->owner, p_args, p_argument_count), false);
 	}
 	else {
@@ -382,6 +390,7 @@ GDExtensionScriptInstanceInfo3 *LuaScriptInstance::get_script_instance_info() {
 }
 
 LuaScriptInstance *LuaScriptInstance::attached_to_object(Object *owner) {
+	std::shared_lock lock(owner_to_instance_mutex);
 	if (LuaScriptInstance **ptr = owner_to_instance.getptr(owner)) {
 		return *ptr;
 	}
@@ -405,20 +414,32 @@ static void _rawset(const Variant& self, const Variant& index, const Variant& va
 	}
 }
 
+// Kept in each state's registry, since scripts may run in one state per thread
+static const char RAWGET_KEY[] = "_GDEXTENSION_SCRIPT_RAWGET";
+static const char RAWSET_KEY[] = "_GDEXTENSION_SCRIPT_RAWSET";
+
 void LuaScriptInstance::register_lua(lua_State *L) {
 	sol::state_view state(L);
-	rawget = wrap_function(L, _rawget);
-	rawset = wrap_function(L, _rawset);
+	state.registry()[RAWGET_KEY] = wrap_function(L, _rawget);
+	state.registry()[RAWSET_KEY] = wrap_function(L, _rawset);
 	LuaScriptInstanceMethodBind::register_usertype(state);
 }
 
 void LuaScriptInstance::unregister_lua(lua_State *L) {
-	rawget = {};
-	rawset = {};
+	sol::state_view state(L);
+	state.registry()[RAWGET_KEY] = sol::nil;
+	state.registry()[RAWSET_KEY] = sol::nil;
+}
+
+sol::protected_function LuaScriptInstance::get_rawget(lua_State *L) {
+	return sol::state_view(L).registry()[RAWGET_KEY];
+}
+
+sol::protected_function LuaScriptInstance::get_rawset(lua_State *L) {
+	return sol::state_view(L).registry()[RAWSET_KEY];
 }
 
 HashMap<Object *, LuaScriptInstance *> LuaScriptInstance::owner_to_instance;
-sol::protected_function LuaScriptInstance::rawget;
-sol::protected_function LuaScriptInstance::rawset;
+std::shared_mutex LuaScriptInstance::owner_to_instance_mutex;
 
 }
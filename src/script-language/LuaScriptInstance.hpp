@@ -22,6 +22,8 @@
 #ifndef __LUA_SCRIPT_INSTANCE_HPP__
 #define __LUA_SCRIPT_INSTANCE_HPP__
 
+#include <shared_mutex>
+
 #include <godot_cpp/classes/ref.hpp>
 #include <godot_cpp/templates/hash_map.hpp>
 #include "../utils/custom_sol.hpp"
@@ -47,12 +49,15 @@ struct LuaScriptInstance {
 
 	static void register_lua(lua_State *L);
 	static void unregister_lua(lua_State *L);
-	
-	static sol::protected_function rawget;
-	static sol::protected_function rawset;
+
+	// `rawget` and `rawset` functions registered in the state of `L`
+	static sol::protected_function get_rawget(lua_State *L);
+	static sol::protected_function get_rawset(lua_State *L);
 
 private:
+	// Objects with Lua scripts may be created and freed in any thread
 	static HashMap<Object *, LuaScriptInstance *> owner_to_instance;
+	static std::shared_mutex owner_to_instance_mutex;
 };
 
 }
@@ -24,49 +24,64 @@
 #include "LuaScript.hpp"
 #include "LuaScriptInstance.hpp"
 #include "LuaScriptMethod.hpp"
+#include "LuaScriptProfiler.hpp"
 #include "LuaScriptProperty.hpp"
 #include "LuaScriptSignal.hpp"
 #include "../LuaError.hpp"
+#include "../LuaFunction.hpp"
 #include "../LuaTable.hpp"
 #include "../LuaState.hpp"
 #include "../generated/lua_script_globals.h"
+#include "../utils/performance_monitors.hpp"
 #include "../utils/project_settings.hpp"
 
+#include <atomic>
+
 #include <godot_cpp/classes/engine.hpp>
 #include <godot_cpp/classes/project_settings.hpp>
 #include <godot_cpp/classes/reg_ex.hpp>
 #include <godot_cpp/classes/reg_ex_match.hpp>
 #include <godot_cpp/classes/resource_loader.hpp>
+#include <godot_cpp/templates/local_vector.hpp>
 #include <godot_cpp/variant/dictionary.hpp>
 #include <godot_cpp/variant/packed_string_array.hpp>
 
 namespace luagdextension {
 
+struct LuaScriptLanguage::ThreadScriptState {
+	struct ThreadScript {
+		uint64_t version;
+		LuaScriptMetadata metadata;
+	};
+
+	// Declared before `scripts`, so that metadata references are released before the state is closed
+	Ref<LuaState> lua_state;
+	HashMap<const LuaScript *, ThreadScript> scripts;
+	// Scripts freed since the thread last ran a script, guarded by `thread_script_states_mutex`
+	LocalVector<const LuaScript *> freed_scripts;
+	std::atomic<bool> has_freed_scripts = false;
+
+	~ThreadScriptState() {
+		scripts.clear();
+		teardown_script_state(lua_state.ptr());
+	}
+};
+
 String LuaScriptLanguage::_get_name() const {
 	return "Lua";
 }
 
 void LuaScriptLanguage::_init() {
 	lua_state.instantiate();
-	lua_state->open_libraries();
+	setup_script_state(lua_state.ptr());
 
 	lua_parser.instantiate();
 
-	// Register scripting specific usertypes
-	sol::state_view state = lua_state->get_lua_state();
-	LuaScriptInstance::register_lua(state);
-	LuaScriptMetadata::register_lua(state);
-	LuaScriptMethod::register_lua(state);
-	LuaScriptProperty::register_lua(state);
-	LuaScriptSignal::register_lua(state);
-
-	// Apply project settings (package.path, package.cpath)
+	// GC frame budget is only used in the main thread's LuaState
 	ProjectSettings *project_settings = ProjectSettings::get_singleton();
-	lua_state->set_package_path(project_settings->get_setting_with_override(LUA_PATH_SETTING));
-	lua_state->set_package_cpath(project_settings->get_setting_with_override(LUA_CPATH_SETTING));
+	lua_state->set_gc_frame_budget_usec(project_settings->get_setting_with_override(LUA_GC_FRAME_BUDGET_SETTING));
 
-	// Additional globals defined in Lua code
-	lua_state->do_string(lua_script_globals);
+	register_performance_monitors();
 }
 
 String LuaScriptLanguage::_get_type() const {
@@ -78,9 +93,16 @@ String LuaScriptLanguage::_get_extension() const {
 }
 
 void LuaScriptLanguage::_finish() {
-	// Run a full GC to make sure we collect dead LuaScriptInstances, which reference this LuaState back and would leak
-	lua_state->get_lua_state().collect_garbage();
-	LuaScriptInstance::unregister_lua(lua_state->get_lua_state());
+	unregister_performance_monitors();
+	{
+		std::lock_guard lock(thread_script_states_mutex);
+		for (ThreadScriptState *state : thread_script_states) {
+			memdelete(state);
+		}
+		thread_script_states.clear();
+	}
+	teardown_script_state(lua_state.ptr());
+	LuaScriptProfiler::clear();
 	lua_parser.unref();
 	lua_state.unref();
 }
@@ -255,24 +277,43 @@ String LuaScriptLanguage::_auto_indent_code(const String &p_code, int32_t p_from
 }
 
 void LuaScriptLanguage::_add_global_constant(const StringName &p_name, const Variant &p_value) {
-	named_globals[p_name] = p_value;
+	{
+		std::lock_guard lock(named_globals_mutex);
+		named_globals[p_name] = p_value;
+	}
 	lua_state->get_globals()->set(p_name, p_value);
 }
 
 void LuaScriptLanguage::_add_named_global_constant(const StringName &p_name, const Variant &p_value) {
-	named_globals[p_name] = p_value;
+	{
+		std::lock_guard lock(named_globals_mutex);
+		named_globals[p_name] = p_value;
+	}
 	lua_state->get_globals()->set(p_name, p_value);
 }
 
 void LuaScriptLanguage::_remove_named_global_constant(const StringName &p_name) {
-	named_globals.erase(p_name);
+	{
+		std::lock_guard lock(named_globals_mutex);
+		named_globals.erase(p_name);
+	}
 	lua_state->get_globals()->set(p_name, nullptr);
 }
 
 void LuaScriptLanguage::_thread_enter() {
+	// The thread's LuaState is only created when a script runs in it, see `get_thread_metadata`
+	thread_entered = true;
 }
 
 void LuaScriptLanguage::_thread_exit() {
+	thread_entered = false;
+	if (thread_script_state) {
+		std::lock_guard lock(thread_script_states_mutex);
+		if (thread_script_states.erase(thread_script_state)) {
+			memdelete(thread_script_state);
+		}
+		thread_script_state = nullptr;
+	}
 }
 
 String LuaScriptLanguage::_debug_get_error() const {
@@ -361,11 +402,11 @@ TypedArray<Dictionary> LuaScriptLanguage::_get_public_annotations() const {
 }
 
 void LuaScriptLanguage::_profiling_start() {
-	// TODO
+	LuaScriptProfiler::start();
 }
 
 void LuaScriptLanguage::_profiling_stop() {
-	// TODO
+	LuaScriptProfiler::stop();
 }
 
 void LuaScriptLanguage::_profiling_set_save_native_calls(bool p_enable) {
@@ -373,16 +414,17 @@ void LuaScriptLanguage::_profiling_set_save_native_calls(bool p_enable) {
 }
 
 int32_t LuaScriptLanguage::_profiling_get_accumulated_data(ScriptLanguageExtensionProfilingInfo *p_info_array, int32_t p_info_max) {
-	// TODO
-	return {};
+	return LuaScriptProfiler::get_accumulated_data(p_info_array, p_info_max);
 }
 
 int32_t LuaScriptLanguage::_profiling_get_frame_data(ScriptLanguageExtensionProfilingInfo *p_info_array, int32_t p_info_max) {
-	// TODO
-	return {};
+	return LuaScriptProfiler::get_frame_data(p_info_array, p_info_max);
 }
 
 void LuaScriptLanguage::_frame() {
+	LuaScriptProfiler::frame();
+	LuaState::process_gc_frame();
+	performance_monitors_frame();
 }
 
 bool LuaScriptLanguage::_handles_global_class_type(const String &type) const {
@@ -423,8 +465,9 @@ PackedStringArray LuaScriptLanguage::get_lua_member_keywords() const {
 	);
 }
 
-const Dictionary& LuaScriptLanguage::get_named_globals() const {
-	return named_globals;
+Variant LuaScriptLanguage::get_named_global(const StringName& name) const {
+	std::lock_guard lock(named_globals_mutex);
+	return named_globals.get(name, Variant());
 }
 
 LuaState *LuaScriptLanguage::get_lua_state() {
@@ -435,6 +478,101 @@ LuaParser *LuaScriptLanguage::get_lua_parser() const {
 	return lua_parser.ptr();
 }
 
+const LuaScriptMetadata *LuaScriptLanguage::get_thread_metadata(const LuaScript *script) {
+	if (!thread_entered) {
+		return nullptr;
+	}
+
+	// Scripts that were never loaded successfully have no metadata in any thread
+	uint64_t version = script->get_metadata_version();
+	if (version == 0) {
+		return nullptr;
+	}
+
+	if (thread_script_state == nullptr) {
+		thread_script_state = memnew(ThreadScriptState);
+		thread_script_state->lua_state.instantiate();
+		setup_script_state(thread_script_state->lua_state.ptr());
+		Dictionary globals_snapshot;
+		{
+			std::lock_guard lock(named_globals_mutex);
+			globals_snapshot = named_globals.duplicate();
+		}
+		Ref<LuaTable> globals = thread_script_state->lua_state->get_globals();
+		Array names = globals_snapshot.keys();
+		for (int i = 0; i < names.size(); i++) {
+			globals->set(names[i], globals_snapshot[names[i]]);
+		}
+
+		std::lock_guard lock(thread_script_states_mutex);
+		thread_script_states.insert(thread_script_state);
+	}
+
+	if (thread_script_state->has_freed_scripts.load(std::memory_order_acquire)) {
+		std::lock_guard lock(thread_script_states_mutex);
+		for (const LuaScript *freed_script : thread_script_state->freed_scripts) {
+			thread_script_state->scripts.erase(freed_script);
+		}
+		thread_script_state->freed_scripts.clear();
+		thread_script_state->has_freed_scripts.store(false, std::memory_order_relaxed);
+	}
+
+	// Reload the script in this thread whenever it was reloaded in the main thread
+	ThreadScriptState::ThreadScript *thread_script = thread_script_state->scripts.getptr(script);
+	if (thread_script == nullptr || thread_script->version != version) {
+		String source_code = script->get_loaded_source_code(version);
+		thread_script = &thread_script_state->scripts[script];
+		thread_script->version = version;
+		thread_script->metadata.clear();
+
+		Variant result = thread_script_state->lua_state->load_string(source_code, script->get_path());
+		if (LuaFunction *function = Object::cast_to<LuaFunction>(result)) {
+			result = function->invokev(Array());
+		}
+		if (LuaTable *table = Object::cast_to<LuaTable>(result)) {
+			thread_script->metadata.setup(table->get_table());
+		}
+		else {
+			ERR_PRINT(String("Could not load script '%s' in thread: %s") % Array::make(script->get_path(), result));
+		}
+	}
+	return thread_script->metadata.is_valid ? &thread_script->metadata : nullptr;
+}
+
+void LuaScriptLanguage::script_freed(const LuaScript *script) {
+	std::lock_guard lock(thread_script_states_mutex);
+	for (ThreadScriptState *state : thread_script_states) {
+		state->freed_scripts.push_back(script);
+		state->has_freed_scripts.store(true, std::memory_order_release);
+	}
+}
+
+void LuaScriptLanguage::setup_script_state(LuaState *state) const {
+	state->open_libraries();
+
+	// Register scripting specific usertypes
+	sol::state_view lua = state->get_lua_state();
+	LuaScriptInstance::register_lua(lua);
+	LuaScriptMetadata::register_lua(lua);
+	LuaScriptMethod::register_lua(lua);
+	LuaScriptProperty::register_lua(lua);
+	LuaScriptSignal::register_lua(lua);
+
+	// Apply project settings (package.path, package.cpath)
+	ProjectSettings *project_settings = ProjectSettings::get_singleton();
+	state->set_package_path(project_settings->get_setting_with_override(LUA_PATH_SETTING));
+	state->set_package_cpath(project_settings->get_setting_with_override(LUA_CPATH_SETTING));
+
+	// Additional globals defined in Lua code
+	state->do_string(lua_script_globals);
+}
+
+void LuaScriptLanguage::teardown_script_state(LuaState *state) {
+	// Run a full GC to make sure we collect dead LuaScriptInstances, which reference this LuaState back and would leak
+	state->get_lua_state().collect_garbage();
+	LuaScriptInstance::unregister_lua(state->get_lua_state());
+}
+
 LuaScriptLanguage *LuaScriptLanguage::get_singleton() {
 	return instance;
 }
@@ -455,9 +593,28 @@ void LuaScriptLanguage::delete_singleton() {
 	}
 }
 
+void LuaScriptLanguage::start_profiling() {
+	LuaScriptProfiler::start();
+}
+
+void LuaScriptLanguage::stop_profiling() {
+	LuaScriptProfiler::stop();
+}
+
+TypedArray<Dictionary> LuaScriptLanguage::get_profiling_data(bool frame_data) {
+	return LuaScriptProfiler::get_data(frame_data);
+}
+
 void LuaScriptLanguage::_bind_methods() {
+	ClassDB::bind_static_method(get_class_static(), D_METHOD("start_profiling"), &LuaScriptLanguage::start_profiling);
+	ClassDB::bind_static_method(get_class_static(), D_METHOD("stop_profiling"), &LuaScriptLanguage::stop_profiling);
+	ClassDB::bind_static_method(get_class_static(), D_METHOD("get_profiling_data", "frame_data"), &LuaScriptLanguage::get_profiling_data, DEFVAL(false));
 }
 
 LuaScriptLanguage *LuaScriptLanguage::instance = nullptr;
+thread_local bool LuaScriptLanguage::thread_entered = false;
+thread_local LuaScriptLanguage::ThreadScriptState *LuaScriptLanguage::thread_script_state = nullptr;
+std::mutex LuaScriptLanguage::thread_script_states_mutex;
+HashSet<LuaScriptLanguage::ThreadScriptState *> LuaScriptLanguage::thread_script_states;
 
 }
@@ -22,8 +22,11 @@
 #ifndef __LUA_SCRIPT_LANGUAGE_EXTENSION_HPP__
 #define __LUA_SCRIPT_LANGUAGE_EXTENSION_HPP__
 
+#include <mutex>
+
 #include <godot_cpp/classes/script.hpp>
 #include <godot_cpp/classes/script_language_extension.hpp>
+#include <godot_cpp/templates/hash_set.hpp>
 
 #include "../LuaParser.hpp"
 #include "../LuaState.hpp"
@@ -32,6 +35,9 @@ using namespace godot;
 
 namespace luagdextension {
 
+class LuaScript;
+struct LuaScriptMetadata;
+
 class LuaScriptLanguage : public ScriptLanguageExtension {
 	GDCLASS(LuaScriptLanguage, ScriptLanguageExtension);
 
@@ -98,11 +104,22 @@ public:
 
 	PackedStringArray get_lua_keywords() const;
 	PackedStringArray get_lua_member_keywords() const;
-	const Dictionary& get_named_globals() const;
+	// Safe to call from any thread
+	Variant get_named_global(const StringName& name) const;
 
 	LuaState *get_lua_state();
 	LuaParser *get_lua_parser() const;
 
+	static void start_profiling();
+	static void stop_profiling();
+	static TypedArray<Dictionary> get_profiling_data(bool frame_data);
+
+	// Metadata of `script` loaded in the calling thread's own LuaState.
+	// Returns null in the main thread and in threads not entered by Godot.
+	const LuaScriptMetadata *get_thread_metadata(const LuaScript *script);
+	// Evicts `script` from every thread's LuaState the next time the thread runs a script
+	void script_freed(const LuaScript *script);
+
 	static LuaScriptLanguage *get_singleton();
 	static LuaScriptLanguage *get_or_create_singleton();
 	static void delete_singleton();
@@ -110,12 +127,24 @@ public:
 protected:
 	static void _bind_methods();
 
+	void setup_script_state(LuaState *state) const;
+	static void teardown_script_state(LuaState *state);
+
 	Ref<LuaState> lua_state;
 	Ref<LuaParser> lua_parser;
+	// Read by other threads when they create their own LuaState
 	Dictionary named_globals;
+	mutable std::mutex named_globals_mutex;
 
 private:
 	static LuaScriptLanguage *instance;
+
+	// Scripts running in other threads, like Nodes in thread groups, use one LuaState per thread
+	struct ThreadScriptState;
+	static thread_local bool thread_entered;
+	static thread_local ThreadScriptState *thread_script_state;
+	static std::mutex thread_script_states_mutex;
+	static HashSet<ThreadScriptState *> thread_script_states;
 };
 
 }
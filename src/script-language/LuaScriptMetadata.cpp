@@ -31,7 +31,8 @@
 
 namespace luagdextension {
 
-static sol::stateless_reference _G_pairs;
+// The original `pairs` function is kept in each state's registry, since scripts may override the global one
+static const char G_PAIRS_KEY[] = "_GDEXTENSION_G_PAIRS";
 
 void LuaScriptMetadata::setup(const sol::table& t) {
 	is_valid = true;
@@ -40,10 +41,10 @@ void LuaScriptMetadata::setup(const sol::table& t) {
 	StackTopResetter topreset(L);
 
 	// Global methods
-	methods[string_names->rawget] = LuaScriptMethod(string_names->rawget, LuaScriptInstance::rawget);
-	methods[string_names->rawset] = LuaScriptMethod(string_names->rawset, LuaScriptInstance::rawset);
+	methods[string_names->rawget] = LuaScriptMethod(string_names->rawget, LuaScriptInstance::get_rawget(L));
+	methods[string_names->rawset] = LuaScriptMethod(string_names->rawset, LuaScriptInstance::get_rawset(L));
 
-	_G_pairs.push(L);
+	lua_getfield(L, LUA_REGISTRYINDEX, G_PAIRS_KEY);
 	t.push();
 	if (lua_pcall(L, 1, 3, 0) != LUA_OK) {
 		ERR_FAIL_MSG(luaL_tolstring(L, -1, nullptr));
@@ -128,7 +129,8 @@ void LuaScriptMetadata::clear() {
 }
 
 void LuaScriptMetadata::register_lua(lua_State *L) {
-	_G_pairs = sol::state_view(L).globals()["pairs"];
+	lua_getglobal(L, "pairs");
+	lua_setfield(L, LUA_REGISTRYINDEX, G_PAIRS_KEY);
 }
 
 }
@@ -0,0 +1,244 @@
+/**
+ * Copyright (C) 2026 Gil Barbosa Reis.
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the “Software”), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ * of the Software, and to permit persons to whom the Software is furnished to do
+ * so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#include "LuaScriptProfiler.hpp"
+
+#include "LuaScript.hpp"
+#include "LuaScriptInstance.hpp"
+#include "LuaScriptMethod.hpp"
+
+#include <godot_cpp/classes/time.hpp>
+
+namespace luagdextension {
+
+LuaScriptProfiler::CallScope::CallScope(const LuaScriptInstance *instance, const LuaScriptMethod *method) {
+	if (!profiling.load(std::memory_order_relaxed)) {
+		return;
+	}
+
+	generation = LuaScriptProfiler::generation.load(std::memory_order_relaxed);
+	ThreadProfiles& thread = thread_profiles;
+	if (thread.generation != generation) {
+		thread.reset(generation);
+	}
+	ThreadFunctionProfile *profile = thread.get_profile(instance, method, generation);
+
+	active = true;
+	call_stack.push_back({ profile, Time::get_singleton()->get_ticks_usec(), 0 });
+}
+
+LuaScriptProfiler::CallScope::~CallScope() {
+	if (!active || call_stack.is_empty()) {
+		return;
+	}
+
+	ActiveCall call = call_stack[call_stack.size() - 1];
+	call_stack.remove_at(call_stack.size() - 1);
+
+	uint64_t total_time = Time::get_singleton()->get_ticks_usec() - call.start_usec;
+	uint64_t self_time = total_time > call.children_usec ? total_time - call.children_usec : 0;
+	if (!call_stack.is_empty()) {
+		call_stack[call_stack.size() - 1].children_usec += total_time;
+	}
+
+	// Profiling may have been restarted or stopped during the call, which frees `call.profile` in the next call
+	if (generation != LuaScriptProfiler::generation.load(std::memory_order_relaxed)) {
+		return;
+	}
+	call.profile->call_count.fetch_add(1, std::memory_order_relaxed);
+	call.profile->total_time.fetch_add(total_time, std::memory_order_relaxed);
+	call.profile->self_time.fetch_add(self_time, std::memory_order_relaxed);
+}
+
+LuaScriptProfiler::ThreadProfiles::ThreadProfiles() {
+	std::lock_guard lock(profiles_mutex);
+	thread_profiles_list.push_back(this);
+}
+
+LuaScriptProfiler::ThreadProfiles::~ThreadProfiles() {
+	{
+		std::lock_guard lock(profiles_mutex);
+		merge();
+		thread_profiles_list.erase(this);
+	}
+	reset(0);
+}
+
+LuaScriptProfiler::ThreadFunctionProfile *LuaScriptProfiler::ThreadProfiles::get_profile(const LuaScriptInstance *instance, const LuaScriptMethod *method, uint32_t generation) {
+	LuaFunction *function = method->method.ptr();
+	if (ThreadFunctionProfile **profile = profiles.getptr(function)) {
+		return *profile;
+	}
+
+	// First call in this thread, make sure the shared profile exists, so that it keeps `function` alive
+	std::lock_guard lock(profiles_mutex);
+	if (generation == LuaScriptProfiler::generation.load(std::memory_order_relaxed) && !LuaScriptProfiler::profiles.has(function)) {
+		FunctionProfile& shared_profile = LuaScriptProfiler::profiles[function];
+		shared_profile.function = method->method;
+		shared_profile.signature = instance->script->get_path() + "::" + itos(method->get_line_defined()) + "::" + method->name;
+	}
+	std::lock_guard thread_lock(mutex);
+	ThreadFunctionProfile *profile = memnew(ThreadFunctionProfile);
+	profiles.insert(function, profile);
+	return profile;
+}
+
+void LuaScriptProfiler::ThreadProfiles::reset(uint32_t generation) {
+	std::lock_guard lock(mutex);
+	for (KeyValue<LuaFunction *, ThreadFunctionProfile *>& it : profiles) {
+		memdelete(it.value);
+	}
+	profiles.clear();
+	this->generation = generation;
+}
+
+void LuaScriptProfiler::ThreadProfiles::merge() {
+	std::lock_guard lock(mutex);
+	if (generation != LuaScriptProfiler::generation.load(std::memory_order_relaxed)) {
+		return;
+	}
+	for (KeyValue<LuaFunction *, ThreadFunctionProfile *>& it : profiles) {
+		FunctionProfile *profile = LuaScriptProfiler::profiles.getptr(it.key);
+		if (profile == nullptr) {
+			continue;
+		}
+		uint64_t call_count = it.value->call_count.exchange(0, std::memory_order_relaxed);
+		uint64_t total_time = it.value->total_time.exchange(0, std::memory_order_relaxed);
+		uint64_t self_time = it.value->self_time.exchange(0, std::memory_order_relaxed);
+		profile->call_count += call_count;
+		profile->total_time += total_time;
+		profile->self_time += self_time;
+		profile->frame_call_count += call_count;
+		profile->frame_total_time += total_time;
+		profile->frame_self_time += self_time;
+	}
+}
+
+void LuaScriptProfiler::merge_thread_profiles() {
+	for (ThreadProfiles *thread : thread_profiles_list) {
+		thread->merge();
+	}
+}
+
+void LuaScriptProfiler::start() {
+	std::lock_guard lock(profiles_mutex);
+	profiles.clear();
+	generation++;
+	profiling = true;
+}
+
+void LuaScriptProfiler::stop() {
+	std::lock_guard lock(profiles_mutex);
+	// Thread counters are discarded once the generation changes
+	merge_thread_profiles();
+	generation++;
+	profiling = false;
+}
+
+bool LuaScriptProfiler::is_profiling() {
+	return profiling;
+}
+
+void LuaScriptProfiler::frame() {
+	if (!profiling) {
+		return;
+	}
+	std::lock_guard lock(profiles_mutex);
+	merge_thread_profiles();
+	for (KeyValue<LuaFunction *, FunctionProfile>& it : profiles) {
+		it.value.frame_call_count = 0;
+		it.value.frame_total_time = 0;
+		it.value.frame_self_time = 0;
+	}
+}
+
+void LuaScriptProfiler::clear() {
+	std::lock_guard lock(profiles_mutex);
+	generation++;
+	profiling = false;
+	profiles.clear();
+}
+
+int32_t LuaScriptProfiler::get_accumulated_data(ScriptLanguageExtensionProfilingInfo *info_array, int32_t info_max) {
+	std::lock_guard lock(profiles_mutex);
+	merge_thread_profiles();
+	int32_t count = 0;
+	for (const KeyValue<LuaFunction *, FunctionProfile>& it : profiles) {
+		if (count >= info_max) {
+			break;
+		}
+		ScriptLanguageExtensionProfilingInfo& info = info_array[count++];
+		info.signature = it.value.signature;
+		info.call_count = it.value.call_count;
+		info.total_time = it.value.total_time;
+		info.self_time = it.value.self_time;
+	}
+	return count;
+}
+
+int32_t LuaScriptProfiler::get_frame_data(ScriptLanguageExtensionProfilingInfo *info_array, int32_t info_max) {
+	std::lock_guard lock(profiles_mutex);
+	merge_thread_profiles();
+	int32_t count = 0;
+	for (const KeyValue<LuaFunction *, FunctionProfile>& it : profiles) {
+		if (count >= info_max) {
+			break;
+		}
+		if (it.value.frame_call_count == 0) {
+			continue;
+		}
+		ScriptLanguageExtensionProfilingInfo& info = info_array[count++];
+		info.signature = it.value.signature;
+		info.call_count = it.value.frame_call_count;
+		info.total_time = it.value.frame_total_time;
+		info.self_time = it.value.frame_self_time;
+	}
+	return count;
+}
+
+TypedArray<Dictionary> LuaScriptProfiler::get_data(bool frame_data) {
+	std::lock_guard lock(profiles_mutex);
+	merge_thread_profiles();
+	TypedArray<Dictionary> data;
+	for (const KeyValue<LuaFunction *, FunctionProfile>& it : profiles) {
+		uint64_t call_count = frame_data ? it.value.frame_call_count : it.value.call_count;
+		if (call_count == 0) {
+			continue;
+		}
+		Dictionary info;
+		info["signature"] = it.value.signature;
+		info["call_count"] = call_count;
+		info["total_time"] = frame_data ? it.value.frame_total_time : it.value.total_time;
+		info["self_time"] = frame_data ? it.value.frame_self_time : it.value.self_time;
+		data.append(info);
+	}
+	return data;
+}
+
+std::atomic<bool> LuaScriptProfiler::profiling = false;
+std::atomic<uint32_t> LuaScriptProfiler::generation = 0;
+std::mutex LuaScriptProfiler::profiles_mutex;
+HashMap<LuaFunction *, LuaScriptProfiler::FunctionProfile> LuaScriptProfiler::profiles;
+LocalVector<LuaScriptProfiler::ThreadProfiles *> LuaScriptProfiler::thread_profiles_list;
+thread_local LuaScriptProfiler::ThreadProfiles LuaScriptProfiler::thread_profiles;
+thread_local LocalVector<LuaScriptProfiler::ActiveCall> LuaScriptProfiler::call_stack;
+
+}
@@ -0,0 +1,130 @@
+/**
+ * Copyright (C) 2026 Gil Barbosa Reis.
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the “Software”), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ * of the Software, and to permit persons to whom the Software is furnished to do
+ * so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#ifndef __LUA_SCRIPT_PROFILER_HPP__
+#define __LUA_SCRIPT_PROFILER_HPP__
+
+#include <atomic>
+#include <mutex>
+
+#include <godot_cpp/classes/script_language_extension.hpp>
+#include <godot_cpp/templates/hash_map.hpp>
+#include <godot_cpp/templates/local_vector.hpp>
+#include <godot_cpp/variant/typed_array.hpp>
+
+#include "../LuaFunction.hpp"
+
+using namespace godot;
+
+namespace luagdextension {
+
+struct LuaScriptInstance;
+struct LuaScriptMethod;
+
+/**
+ * Collects call count, self time and total time of Lua script methods for Godot's profiler.
+ *
+ * Script method calls are instrumented with `LuaScriptProfiler::CallScope`,
+ * which costs a single boolean check while profiling is disabled.
+ * Scripts may run in several threads, each one with its own call stack and counters.
+ * Thread counters are merged into the shared profiles only when profiling data is read or a frame ends.
+ */
+class LuaScriptProfiler {
+public:
+	struct CallScope {
+		CallScope(const LuaScriptInstance *instance, const LuaScriptMethod *method);
+		~CallScope();
+
+	private:
+		bool active = false;
+		uint32_t generation;
+	};
+
+	static void start();
+	static void stop();
+	static bool is_profiling();
+	static void frame();
+	static void clear();
+
+	static int32_t get_accumulated_data(ScriptLanguageExtensionProfilingInfo *info_array, int32_t info_max);
+	static int32_t get_frame_data(ScriptLanguageExtensionProfilingInfo *info_array, int32_t info_max);
+	// Same data as `get_accumulated_data` or `get_frame_data`, as Dictionaries that can be used from scripts
+	static TypedArray<Dictionary> get_data(bool frame_data);
+
+private:
+	struct FunctionProfile {
+		// Keeps the LuaFunction used as key alive, so that its address is not reused
+		Ref<LuaFunction> function;
+		StringName signature;
+		uint64_t call_count = 0;
+		uint64_t total_time = 0;
+		uint64_t self_time = 0;
+		uint64_t frame_call_count = 0;
+		uint64_t frame_total_time = 0;
+		uint64_t frame_self_time = 0;
+	};
+
+	// Counters updated by a single thread since they were last merged into `profiles`
+	struct ThreadFunctionProfile {
+		std::atomic<uint64_t> call_count = 0;
+		std::atomic<uint64_t> total_time = 0;
+		std::atomic<uint64_t> self_time = 0;
+	};
+
+	struct ThreadProfiles {
+		ThreadProfiles();
+		~ThreadProfiles();
+
+		ThreadFunctionProfile *get_profile(const LuaScriptInstance *instance, const LuaScriptMethod *method, uint32_t generation);
+		void reset(uint32_t generation);
+		// Must be called with `profiles_mutex` locked
+		void merge();
+
+		// Only changed by the owner thread, with `mutex` locked
+		uint32_t generation = 0;
+		// Guards insertions in `profiles`, which may be iterated by other threads while merging
+		std::mutex mutex;
+		HashMap<LuaFunction *, ThreadFunctionProfile *> profiles;
+	};
+
+	struct ActiveCall {
+		ThreadFunctionProfile *profile;
+		uint64_t start_usec;
+		uint64_t children_usec;
+	};
+
+	// Must be called with `profiles_mutex` locked
+	static void merge_thread_profiles();
+
+	static std::atomic<bool> profiling;
+	// Changes when profiling starts or stops, so that calls started before are not recorded
+	static std::atomic<uint32_t> generation;
+	// Guards `profiles`, `thread_profiles_list` and changes to `generation`
+	static std::mutex profiles_mutex;
+	static HashMap<LuaFunction *, FunctionProfile> profiles;
+	static LocalVector<ThreadProfiles *> thread_profiles_list;
+	static thread_local ThreadProfiles thread_profiles;
+	static thread_local LocalVector<ActiveCall> call_stack;
+};
+
+}
+
+#endif  // __LUA_SCRIPT_PROFILER_HPP__
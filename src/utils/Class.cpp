@@ -71,18 +71,52 @@ bool Class::operator==(const Class& other) const {
 	return class_name == other.class_name;
 }
 
-static sol::object __index(sol::this_state state, const Class& cls, sol::stack_object key) {
-	if (key.get_type() == sol::type::string) {
-		StringName name = key.as<StringName>();
-		if (auto constant = cls.get_constant(name)) {
-			return sol::make_object(state, *constant);
-		}
-		else if (ClassDBSingleton::get_singleton()->class_has_method(cls.get_name(), name)) {
-			return sol::make_object(state, ClassMethodBind(cls, name));
+// Weak table of { Class userdata: { name: constant or method bind } }, filled lazily by `__index`
+static const char CLASS_CACHE_KEY[] = "_GDEXTENSION_CLASS_CACHE";
+
+static int __index(lua_State *L) {
+	lua_getfield(L, LUA_REGISTRYINDEX, CLASS_CACHE_KEY);
+	lua_pushvalue(L, 1);
+	lua_rawget(L, -2);
+	if (lua_istable(L, -1)) {
+		lua_pushvalue(L, 2);
+		lua_rawget(L, -2);
+		if (!lua_isnil(L, -1)) {
+			return 1;
 		}
+		lua_pop(L, 1);
+	}
+	else {
+		lua_pop(L, 1);
+		lua_newtable(L);
+		lua_pushvalue(L, 1);
+		lua_pushvalue(L, -2);
+		lua_rawset(L, -4);
+	}
+
+	if (lua_type(L, 2) != LUA_TSTRING) {
+		lua_pushnil(L);
+		return 1;
 	}
-	return sol::nil;
+	const Class& cls = sol::stack::get<const Class&>(L, 1);
+	StringName name = sol::stack::get<StringName>(L, 2);
+	if (auto constant = cls.get_constant(name)) {
+		lua_pushinteger(L, *constant);
+	}
+	else if (ClassDBSingleton::get_singleton()->class_has_method(cls.get_name(), name)) {
+		sol::stack::push(L, ClassMethodBind(cls, name));
+	}
+	else {
+		// Misses are not cached, so classes registered later are still found
+		lua_pushnil(L);
+		return 1;
+	}
+	lua_pushvalue(L, 2);
+	lua_pushvalue(L, -2);
+	lua_rawset(L, -4);
+	return 1;
 }
+
 void Class::register_usertype(sol::state_view& state) {
 	state.new_usertype<Class>(
 		"Class",
@@ -91,6 +125,9 @@ void Class::register_usertype(sol::state_view& state) {
 		sol::meta_function::to_string, &Class::get_name
 	);
 	ClassMethodBind::register_usertype(state);
+	state.registry()[CLASS_CACHE_KEY] = state.create_table_with(
+		sol::metatable_key, state.create_table_with("__mode", "k")
+	);
 }
 
 }
@@ -0,0 +1,81 @@
+/**
+ * Copyright (C) 2026 Gil Barbosa Reis.
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the “Software”), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ * of the Software, and to permit persons to whom the Software is furnished to do
+ * so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#include "InstructionBudget.hpp"
+
+namespace luagdextension {
+
+// Hook granularity: the budget is checked at least this often
+constexpr int MAX_HOOK_COUNT = 1024;
+
+InstructionBudget::InstructionBudget(lua_State *thread, int64_t max_instructions, bool yield_when_exhausted)
+	: thread(thread)
+	, dispatcher(LuaHookDispatcher::get(thread))
+	, remaining(max_instructions)
+	, yield_when_exhausted(yield_when_exhausted)
+{
+	hook_count = next_hook_count();
+	ERR_FAIL_NULL(dispatcher);
+	dispatcher->add(this, hook, this, LUA_MASKCOUNT, hook_count);
+	dispatcher->update(thread);
+}
+
+InstructionBudget::~InstructionBudget() {
+	if (dispatcher) {
+		dispatcher->remove(this);
+	}
+}
+
+bool InstructionBudget::is_exhausted() const {
+	return exhausted;
+}
+
+int64_t InstructionBudget::get_remaining() const {
+	return remaining;
+}
+
+int InstructionBudget::next_hook_count() const {
+	return remaining < MAX_HOOK_COUNT ? (int) MAX(remaining, 1) : MAX_HOOK_COUNT;
+}
+
+void InstructionBudget::hook(lua_State *L, lua_Debug *ar, void *userdata) {
+	InstructionBudget *budget = (InstructionBudget *) userdata;
+	budget->remaining -= budget->hook_count;
+	if (budget->remaining > 0) {
+		budget->hook_count = budget->next_hook_count();
+		budget->dispatcher->set_count(budget, budget->hook_count, L);
+		return;
+	}
+
+	budget->remaining = 0;
+	budget->exhausted = true;
+	if (budget->yield_when_exhausted && L == budget->thread && lua_isyieldable(L)) {
+		lua_yield(L, 0);
+	}
+	else {
+		// Fail again on the next instruction, in case the error is caught by `pcall`
+		budget->hook_count = 1;
+		budget->dispatcher->set_count(budget, 1, L);
+		luaL_error(L, "instruction budget exceeded");
+	}
+}
+
+}
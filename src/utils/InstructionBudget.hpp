@@ -0,0 +1,62 @@
+/**
+ * Copyright (C) 2026 Gil Barbosa Reis.
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the “Software”), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ * of the Software, and to permit persons to whom the Software is furnished to do
+ * so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#ifndef __UTILS_INSTRUCTION_BUDGET_HPP__
+#define __UTILS_INSTRUCTION_BUDGET_HPP__
+
+#include "custom_sol.hpp"
+#include "LuaHookDispatcher.hpp"
+
+namespace luagdextension {
+
+/**
+ * Scoped VM instruction budget for a Lua thread.
+ *
+ * Adds a native count hook to the state's hook dispatcher, removing it on destruction.
+ * When the budget runs out, the hook either yields the thread or raises
+ * an "instruction budget exceeded" error that keeps being raised until
+ * the stack unwinds, so that `pcall` cannot swallow it.
+ * Coroutines created while the budget is active inherit the hook and consume the same budget.
+ */
+class InstructionBudget {
+public:
+	InstructionBudget(lua_State *thread, int64_t max_instructions, bool yield_when_exhausted);
+	~InstructionBudget();
+
+	bool is_exhausted() const;
+	int64_t get_remaining() const;
+
+private:
+	lua_State *thread;
+	LuaHookDispatcher *dispatcher;
+	int64_t remaining;
+	// Instructions between count events, subtracted from `remaining` on each event
+	int hook_count;
+	bool yield_when_exhausted;
+	bool exhausted = false;
+
+	int next_hook_count() const;
+	static void hook(lua_State *L, lua_Debug *ar, void *budget);
+};
+
+}
+
+#endif  // __UTILS_INSTRUCTION_BUDGET_HPP__
@@ -1,15 +1,30 @@
 #include "LuaCallable.hpp"
 #include "godot_cpp/variant/callable.hpp"
 #include "godot_cpp/variant/variant.hpp"
+#include "godot_cpp/templates/hashfuncs.hpp"
+#include "../LuaTracer.hpp"
 
 namespace luagdextension {
 
+// LuaFunction objects are unique per Lua function, so Callables are compared by the wrapped function's identity
+static bool lua_callable_compare_equal(const CallableCustom *a, const CallableCustom *b) {
+	return ((const LuaCallable *) a)->get_lua_function() == ((const LuaCallable *) b)->get_lua_function();
+}
+
+static bool lua_callable_compare_less(const CallableCustom *a, const CallableCustom *b) {
+	return ((const LuaCallable *) a)->get_lua_function().ptr() < ((const LuaCallable *) b)->get_lua_function().ptr();
+}
+
 LuaCallable::CompareEqualFunc LuaCallable::get_compare_equal_func() const {
-	return nullptr;
+	return lua_callable_compare_equal;
 }
 
 LuaCallable::CompareLessFunc LuaCallable::get_compare_less_func() const {
-	return nullptr;
+	return lua_callable_compare_less;
+}
+
+const Ref<LuaFunction>& LuaCallable::get_lua_function() const {
+	return _lua_func;
 }
 
 bool LuaCallable::is_valid() const {
@@ -25,11 +40,13 @@ String LuaCallable::get_as_text() const {
 }
 
 uint32_t LuaCallable::hash() const {
-	return get_as_text().hash();
+	return hash_one_uint64((uint64_t) _lua_func.ptr());
 }
 
 void LuaCallable::call(const Variant **p_arguments, int p_argcount, Variant &r_return_value, GDExtensionCallError &r_call_error) const {
-	r_return_value =  _lua_func->invoke(p_arguments, p_argcount, r_call_error);
+	LuaTracer::Scope trace_scope(LuaTracer::GODOT_TO_LUA, "LuaCallable::call");
+	r_call_error.error = GDEXTENSION_CALL_OK;
+	r_return_value = LuaFunction::invoke_lua(_lua_func->get_function(), p_arguments, p_argcount, true);
 }
 
 Variant LuaCallable::construct(sol::function func) {
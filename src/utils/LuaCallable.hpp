@@ -18,6 +18,7 @@ public:
 	CompareEqualFunc get_compare_equal_func() const override;
 	CompareLessFunc get_compare_less_func() const override;
 	uint32_t hash() const override;
+	const Ref<LuaFunction>& get_lua_function() const;
 	void call(const Variant **p_arguments, int p_argcount, Variant &r_return_value, GDExtensionCallError &r_call_error) const override;
 	static Variant construct(sol::function func);
 };
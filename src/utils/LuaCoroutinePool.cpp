@@ -22,6 +22,7 @@
 #include "LuaCoroutinePool.hpp"
 
 #include "stack_top_checker.hpp"
+#include "../LuaState.hpp"
 
 namespace luagdextension {
 
@@ -41,6 +42,7 @@ sol::thread LuaCoroutinePool::acquire(const sol::function& f) {
 		lua_settop(lua_tothread(L, -1), 0);  // reset thread
 		lua_pushnil(L);
 		lua_seti(L, pool_index, len);
+		publish_size(len - 1);
 	}
 	else {
 		lua_newthread(L);
@@ -58,9 +60,38 @@ void LuaCoroutinePool::release(const sol::thread& coroutine) {
 	if (coroutine.status() == sol::thread_status::dead) {
 		luaL_getsubtable(L, LUA_REGISTRYINDEX, COROUTINE_POOL_KEY);
 		sol::stack_table pool(L, -1);
-		pool[pool.size() + 1] = coroutine;
+		int size = pool.size() + 1;
+		pool[size] = coroutine;
 		pool.pop();
+		publish_size(size);
 	}
 }
 
+void LuaCoroutinePool::set_hook(lua_Hook hook, int mask, int count) {
+	StackTopChecker topcheck(L);
+	luaL_getsubtable(L, LUA_REGISTRYINDEX, COROUTINE_POOL_KEY);
+	lua_Integer len = luaL_len(L, -1);
+	for (lua_Integer i = 1; i <= len; i++) {
+		lua_geti(L, -1, i);
+		lua_sethook(lua_tothread(L, -1), hook, mask, count);
+		lua_pop(L, 1);
+	}
+	lua_pop(L, 1);
+}
+
+// Performance monitors read the pool size published here, since they run in the main thread
+void LuaCoroutinePool::publish_size(int size) {
+	if (LuaState *lua_state = LuaState::find_lua_state(L)) {
+		lua_state->publish_coroutine_pool_size(size);
+	}
+}
+
+int LuaCoroutinePool::get_size() const {
+	StackTopChecker topcheck(L);
+	luaL_getsubtable(L, LUA_REGISTRYINDEX, COROUTINE_POOL_KEY);
+	int size = (int) luaL_len(L, -1);
+	lua_pop(L, 1);
+	return size;
+}
+
 }
@@ -31,8 +31,12 @@ struct LuaCoroutinePool {
 
 	sol::thread acquire(const sol::function& f);
 	void release(const sol::thread& coroutine);
+	void set_hook(lua_Hook hook, int mask, int count);
+	int get_size() const;
 
 private:
+	void publish_size(int size);
+
 	sol::state_view L;
 };
 
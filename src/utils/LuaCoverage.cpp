@@ -0,0 +1,193 @@
+/**
+ * Copyright (C) 2026 Gil Barbosa Reis.
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the “Software”), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ * of the Software, and to permit persons to whom the Software is furnished to do
+ * so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#include "LuaCoverage.hpp"
+
+#include "LuaHookDispatcher.hpp"
+
+#include <cstring>
+
+namespace luagdextension {
+
+// Registry table with one function per chunk source seen, keeping source strings alive while coverage runs
+static const char COVERAGE_SOURCES_KEY[] = "_GDEXTENSION_COVERAGE_SOURCES";
+
+int64_t& LuaCoverage::Chunk::line(int line) {
+	if (line >= (int) line_hits.size()) {
+		int old_size = line_hits.size();
+		line_hits.resize(line + 1);
+		for (int i = old_size; i < (int) line_hits.size(); i++) {
+			line_hits[i] = -1;
+		}
+	}
+	return line_hits[line];
+}
+
+LuaCoverage::~LuaCoverage() {
+	stop();
+}
+
+void LuaCoverage::start(lua_State *L) {
+	ERR_FAIL_COND_MSG(L == nullptr, "Lua state cannot be null");
+	L = sol::main_thread(L, L);
+	ERR_FAIL_COND_MSG(this->L != nullptr && this->L != L, "Coverage is already running for another Lua state");
+	if (this->L == L) {
+		return;
+	}
+
+	LuaHookDispatcher *dispatcher = LuaHookDispatcher::get(L);
+	ERR_FAIL_NULL(dispatcher);
+	this->L = L;
+	dispatcher->add(this, hook, this, LUA_MASKCALL | LUA_MASKLINE);
+}
+
+void LuaCoverage::stop() {
+	if (L == nullptr) {
+		return;
+	}
+
+	if (LuaHookDispatcher *dispatcher = LuaHookDispatcher::get(L)) {
+		dispatcher->remove(this);
+	}
+	// Source addresses may be reused once their chunks are collected
+	chunk_ids_by_source.clear();
+	lua_pushnil(L);
+	lua_setfield(L, LUA_REGISTRYINDEX, COVERAGE_SOURCES_KEY);
+	L = nullptr;
+}
+
+void LuaCoverage::clear() {
+	chunks.clear();
+	chunk_ids.clear();
+	chunk_ids_by_source.clear();
+}
+
+bool LuaCoverage::is_running() const {
+	return L != nullptr;
+}
+
+Dictionary LuaCoverage::get_line_hits() const {
+	Dictionary result;
+	for (const Chunk& chunk : chunks) {
+		Dictionary lines;
+		for (int line = 0; line < (int) chunk.line_hits.size(); line++) {
+			if (chunk.line_hits[line] >= 0) {
+				lines[line] = chunk.line_hits[line];
+			}
+		}
+		result[chunk.name] = lines;
+	}
+	return result;
+}
+
+String LuaCoverage::to_lcov(const String& test_name) const {
+	PackedStringArray lcov;
+	for (const Chunk& chunk : chunks) {
+		lcov.append("TN:" + test_name);
+		lcov.append("SF:" + chunk.name);
+		int lines_found = 0;
+		int lines_hit = 0;
+		for (int line = 0; line < (int) chunk.line_hits.size(); line++) {
+			int64_t hits = chunk.line_hits[line];
+			if (hits >= 0) {
+				lcov.append(vformat("DA:%d,%d", line, hits));
+				lines_found++;
+				if (hits > 0) {
+					lines_hit++;
+				}
+			}
+		}
+		lcov.append(vformat("LF:%d", lines_found));
+		lcov.append(vformat("LH:%d", lines_hit));
+		lcov.append("end_of_record");
+	}
+	lcov.append("");
+	return String("\n").join(lcov);
+}
+
+LuaCoverage::Chunk& LuaCoverage::get_chunk(lua_State *L, lua_Debug *ar) {
+	if (const int *chunk_id = chunk_ids_by_source.getptr(ar->source)) {
+		return chunks[*chunk_id];
+	}
+
+	// Chunks are identified by their source contents. Addresses are only a cache, valid while the
+	// source string is kept alive by one of its functions stored in the registry.
+	lua_getinfo(L, "f", ar);
+	luaL_getsubtable(L, LUA_REGISTRYINDEX, COVERAGE_SOURCES_KEY);
+	lua_insert(L, -2);
+	lua_rawseti(L, -2, luaL_len(L, -2) + 1);
+	lua_pop(L, 1);
+
+	// "@file" and "=name" sources have their names after the prefix, code strings use the short source
+	String name = ar->source[0] == '@' || ar->source[0] == '=' ? String::utf8(ar->source + 1) : String::utf8(ar->short_src);
+	int chunk_id;
+	if (const int *existing_id = chunk_ids.getptr(name)) {
+		chunk_id = *existing_id;
+	}
+	else {
+		chunk_id = chunks.size();
+		chunks.push_back({ name });
+		chunk_ids.insert(name, chunk_id);
+	}
+	chunk_ids_by_source.insert(ar->source, chunk_id);
+	return chunks[chunk_id];
+}
+
+void LuaCoverage::mark_active_lines(lua_State *L, lua_Debug *ar, Chunk& chunk) {
+	// Functions are identified by their line range, marking lines again for functions with the same range is harmless
+	uint64_t function_key = ((uint64_t) (uint32_t) ar->linedefined << 32) | (uint32_t) ar->lastlinedefined;
+	if (chunk.seen_functions.has(function_key)) {
+		return;
+	}
+	chunk.seen_functions.insert(function_key);
+
+	lua_getinfo(L, "L", ar);
+	if (lua_istable(L, -1)) {
+		lua_pushnil(L);
+		while (lua_next(L, -2)) {
+			int64_t& hits = chunk.line(lua_tointeger(L, -2));
+			if (hits < 0) {
+				hits = 0;
+			}
+			lua_pop(L, 1);
+		}
+	}
+	lua_pop(L, 1);
+}
+
+void LuaCoverage::hook(lua_State *L, lua_Debug *ar, void *userdata) {
+	LuaCoverage *coverage = (LuaCoverage *) userdata;
+	lua_getinfo(L, "S", ar);
+	if (strcmp(ar->what, "C") == 0) {
+		return;
+	}
+
+	Chunk& chunk = coverage->get_chunk(L, ar);
+	if (ar->event == LUA_HOOKLINE) {
+		int64_t& hits = chunk.line(ar->currentline);
+		hits = hits < 0 ? 1 : hits + 1;
+	}
+	else {
+		coverage->mark_active_lines(L, ar, chunk);
+	}
+}
+
+}
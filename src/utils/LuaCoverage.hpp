@@ -0,0 +1,83 @@
+/**
+ * Copyright (C) 2026 Gil Barbosa Reis.
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the “Software”), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ * of the Software, and to permit persons to whom the Software is furnished to do
+ * so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#ifndef __UTILS_LUA_COVERAGE_HPP__
+#define __UTILS_LUA_COVERAGE_HPP__
+
+#include "custom_sol.hpp"
+
+#include <godot_cpp/templates/hash_map.hpp>
+#include <godot_cpp/templates/hash_set.hpp>
+#include <godot_cpp/templates/local_vector.hpp>
+#include <godot_cpp/variant/dictionary.hpp>
+
+using namespace godot;
+
+namespace luagdextension {
+
+/**
+ * Line coverage collector implemented as a native Lua hook.
+ *
+ * Hit counts are stored per chunk in a vector indexed by line number, so
+ * executed lines cost a single hook call with no Godot callbacks.
+ * Call events mark the active lines of each function the first time it runs,
+ * so that lines that were never executed are reported with 0 hits.
+ */
+class LuaCoverage {
+public:
+	~LuaCoverage();
+
+	void start(lua_State *L);
+	void stop();
+	void clear();
+	bool is_running() const;
+
+	// { chunk_name: { line: hits } }
+	Dictionary get_line_hits() const;
+	// LCOV tracefile, one record per chunk
+	String to_lcov(const String& test_name = "") const;
+
+private:
+	// Lines that are not executable are marked with -1
+	struct Chunk {
+		String name;
+		LocalVector<int64_t> line_hits;
+		// Line ranges of functions whose active lines were marked
+		HashSet<uint64_t> seen_functions;
+
+		int64_t& line(int line);
+	};
+
+	lua_State *L = nullptr;
+	LocalVector<Chunk> chunks;
+	HashMap<String, int> chunk_ids;
+	// Cache of chunks by the address of their source strings, which are kept alive while coverage runs
+	HashMap<const char *, int> chunk_ids_by_source;
+
+	Chunk& get_chunk(lua_State *L, lua_Debug *ar);
+	void mark_active_lines(lua_State *L, lua_Debug *ar, Chunk& chunk);
+
+	static void hook(lua_State *L, lua_Debug *ar, void *coverage);
+};
+
+}
+
+#endif  // __UTILS_LUA_COVERAGE_HPP__
@@ -0,0 +1,246 @@
+/**
+ * Copyright (C) 2026 Gil Barbosa Reis.
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the “Software”), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ * of the Software, and to permit persons to whom the Software is furnished to do
+ * so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#include "LuaHookDispatcher.hpp"
+
+#include "LuaCoroutinePool.hpp"
+
+#include <climits>
+
+namespace luagdextension {
+
+// The address of this variable is the registry key for the dispatcher
+static const char HOOK_DISPATCHER_KEY = 0;
+
+static int get_event_mask(int event) {
+	switch (event) {
+		case LUA_HOOKCALL:
+#ifdef LUA_HOOKTAILCALL
+		case LUA_HOOKTAILCALL:
+#endif
+			return LUA_MASKCALL;
+
+		case LUA_HOOKRET:
+#ifdef LUA_HOOKTAILRET
+		case LUA_HOOKTAILRET:
+#endif
+			return LUA_MASKRET;
+
+		case LUA_HOOKLINE:
+			return LUA_MASKLINE;
+
+		case LUA_HOOKCOUNT:
+			return LUA_MASKCOUNT;
+
+		default:
+			return 0;
+	}
+}
+
+LuaHookDispatcher::~LuaHookDispatcher() {
+	detach();
+}
+
+void LuaHookDispatcher::attach(lua_State *L) {
+	detach();
+	this->L = sol::main_thread(L, L);
+	lua_pushlightuserdata(this->L, (void *) &HOOK_DISPATCHER_KEY);
+	lua_pushlightuserdata(this->L, this);
+	lua_rawset(this->L, LUA_REGISTRYINDEX);
+}
+
+void LuaHookDispatcher::detach() {
+	if (L == nullptr) {
+		return;
+	}
+
+	entries.clear();
+	// Coroutines that still have the hook remove it when they don't find the dispatcher
+	lua_sethook(L, nullptr, 0, 0);
+	lua_pushlightuserdata(L, (void *) &HOOK_DISPATCHER_KEY);
+	lua_pushnil(L);
+	lua_rawset(L, LUA_REGISTRYINDEX);
+	L = nullptr;
+}
+
+void LuaHookDispatcher::add(const void *owner, Callback callback, void *userdata, int mask, int count, lua_State *thread) {
+	ERR_FAIL_COND_MSG(L == nullptr, "Hook dispatcher is not attached to a Lua state");
+	ERR_FAIL_NULL(owner);
+	ERR_FAIL_NULL(callback);
+	if (count <= 0) {
+		mask &= ~LUA_MASKCOUNT;
+	}
+
+	Entry *entry = find(owner, thread);
+	if (entry == nullptr) {
+		entry = find(nullptr, nullptr);
+	}
+	if (entry == nullptr) {
+		entries.push_back({});
+		entry = &entries[entries.size() - 1];
+	}
+	*entry = { owner, thread, callback, userdata, mask, count, 0 };
+	install_all(thread);
+}
+
+void LuaHookDispatcher::remove(const void *owner, lua_State *thread) {
+	if (Entry *entry = find(owner, thread)) {
+		*entry = {};
+		install_all(thread);
+	}
+}
+
+void LuaHookDispatcher::remove_all() {
+	for (Entry& entry : entries) {
+		entry = {};
+	}
+	if (L) {
+		install_all(nullptr);
+	}
+}
+
+bool LuaHookDispatcher::has(const void *owner, lua_State *thread) const {
+	return find(owner, thread) != nullptr;
+}
+
+bool LuaHookDispatcher::get_config(const void *owner, lua_State *thread, int *mask, int *count) const {
+	const Entry *entry = find(owner, thread);
+	if (entry == nullptr) {
+		return false;
+	}
+	*mask = entry->mask;
+	*count = entry->count;
+	return true;
+}
+
+void LuaHookDispatcher::set_count(const void *owner, int count, lua_State *running_thread) {
+	for (Entry& entry : entries) {
+		if (entry.owner == owner && (entry.mask & LUA_MASKCOUNT)) {
+			entry.count = MAX(count, 1);
+			entry.elapsed = 0;
+		}
+	}
+	install(running_thread);
+}
+
+void LuaHookDispatcher::update(lua_State *thread) const {
+	install(thread);
+}
+
+LuaHookDispatcher *LuaHookDispatcher::get(lua_State *L) {
+	lua_pushlightuserdata(L, (void *) &HOOK_DISPATCHER_KEY);
+	lua_rawget(L, LUA_REGISTRYINDEX);
+	LuaHookDispatcher *dispatcher = (LuaHookDispatcher *) lua_touserdata(L, -1);
+	lua_pop(L, 1);
+	return dispatcher;
+}
+
+LuaHookDispatcher::Entry *LuaHookDispatcher::find(const void *owner, lua_State *thread) {
+	for (Entry& entry : entries) {
+		if (entry.owner == owner && entry.thread == thread) {
+			return &entry;
+		}
+	}
+	return nullptr;
+}
+
+const LuaHookDispatcher::Entry *LuaHookDispatcher::find(const void *owner, lua_State *thread) const {
+	return const_cast<LuaHookDispatcher *>(this)->find(owner, thread);
+}
+
+void LuaHookDispatcher::compute_config(lua_State *thread, int& mask, int& count) const {
+	mask = 0;
+	count = INT_MAX;
+	for (const Entry& entry : entries) {
+		if (entry.owner == nullptr || (entry.thread != nullptr && entry.thread != thread)) {
+			continue;
+		}
+		mask |= entry.mask;
+		if (entry.mask & LUA_MASKCOUNT) {
+			count = MIN(count, MAX(entry.count - entry.elapsed, 1));
+		}
+	}
+	if (!(mask & LUA_MASKCOUNT)) {
+		count = 0;
+	}
+}
+
+void LuaHookDispatcher::install(lua_State *thread) const {
+	int mask, count;
+	compute_config(thread, mask, count);
+	if (mask) {
+		lua_sethook(thread, hook, mask, count);
+	}
+	else {
+		lua_sethook(thread, nullptr, 0, 0);
+	}
+}
+
+void LuaHookDispatcher::install_all(lua_State *thread) const {
+	// Coroutines created from now on inherit the main thread's hook, but pooled ones already exist
+	int mask, count;
+	compute_config(nullptr, mask, count);
+	LuaCoroutinePool(L).set_hook(mask ? hook : nullptr, mask, count);
+	install(L);
+	if (thread && thread != L) {
+		install(thread);
+	}
+}
+
+void LuaHookDispatcher::hook(lua_State *L, lua_Debug *ar) {
+	LuaHookDispatcher *dispatcher = get(L);
+	if (dispatcher == nullptr) {
+		// Hook inherited by a coroutine that outlived its state's dispatcher
+		lua_sethook(L, nullptr, 0, 0);
+		return;
+	}
+
+	int event = get_event_mask(ar->event);
+	int hook_count = lua_gethookcount(L);
+	// Entries may be added from callbacks, so they are accessed by index
+	for (uint32_t i = 0; i < dispatcher->entries.size(); i++) {
+		Entry& entry = dispatcher->entries[i];
+		if (entry.owner == nullptr || !(entry.mask & event) || (entry.thread != nullptr && entry.thread != L)) {
+			continue;
+		}
+		if (event == LUA_MASKCOUNT) {
+			entry.elapsed += hook_count;
+			if (entry.elapsed < entry.count) {
+				continue;
+			}
+			entry.elapsed = 0;
+		}
+		entry.callback(L, ar, entry.userdata);
+		if (lua_status(L) == LUA_YIELD) {
+			// Callbacks yielded the thread, which must return from the hook right away
+			return;
+		}
+	}
+
+	// Update coroutines that inherited an outdated configuration and the remaining instruction count
+	int mask, count;
+	dispatcher->compute_config(L, mask, count);
+	if (mask != lua_gethookmask(L) || count != lua_gethookcount(L)) {
+		dispatcher->install(L);
+	}
+}
+
+}
@@ -0,0 +1,98 @@
+/**
+ * Copyright (C) 2026 Gil Barbosa Reis.
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the “Software”), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ * of the Software, and to permit persons to whom the Software is furnished to do
+ * so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#ifndef __UTILS_LUA_HOOK_DISPATCHER_HPP__
+#define __UTILS_LUA_HOOK_DISPATCHER_HPP__
+
+#include "custom_sol.hpp"
+
+#include <godot_cpp/templates/local_vector.hpp>
+
+using namespace godot;
+
+namespace luagdextension {
+
+/**
+ * Multiplexes the native debug hook of a Lua state between several owners,
+ * like profilers, coverage, instruction budgets and `LuaThread.set_hook`.
+ *
+ * Each owner registers a callback with its own event mask and instruction count,
+ * optionally restricted to a single Lua thread. A single `lua_Hook` is installed
+ * with the union of masks and the smallest remaining instruction count.
+ * Coroutines that inherited an outdated configuration are updated the next time their hook runs.
+ *
+ * The dispatcher is found from hooks through a light userdata in the registry, without locks.
+ * Owners must be added and removed from the thread that runs the Lua state.
+ */
+class LuaHookDispatcher {
+public:
+	using Callback = void (*)(lua_State *L, lua_Debug *ar, void *userdata);
+
+	~LuaHookDispatcher();
+
+	void attach(lua_State *L);
+	void detach();
+
+	/**
+	 * Adds or replaces the hook of `owner` in `thread`, or in all threads if `thread` is null.
+	 * `count` is the number of VM instructions between count events, used only if `mask` has `LUA_MASKCOUNT`.
+	 */
+	void add(const void *owner, Callback callback, void *userdata, int mask, int count = 0, lua_State *thread = nullptr);
+	void remove(const void *owner, lua_State *thread = nullptr);
+	void remove_all();
+	bool has(const void *owner, lua_State *thread = nullptr) const;
+	bool get_config(const void *owner, lua_State *thread, int *mask, int *count) const;
+	// Changes the instruction count of `owner` and updates `running_thread`, which is safe to call from callbacks
+	void set_count(const void *owner, int count, lua_State *running_thread);
+	// Installs the current configuration in `thread`, for coroutines that existed before hooks were added
+	void update(lua_State *thread) const;
+
+	static LuaHookDispatcher *get(lua_State *L);
+
+private:
+	struct Entry {
+		const void *owner;
+		lua_State *thread;
+		Callback callback;
+		void *userdata;
+		int mask;
+		int count;
+		// Instructions executed since the last count event of this entry
+		int elapsed;
+	};
+
+	lua_State *L = nullptr;
+	// Removed entries are cleared and reused, so entries can be removed while dispatching
+	LocalVector<Entry> entries;
+	lua_State *dispatching_thread = nullptr;
+
+	Entry *find(const void *owner, lua_State *thread);
+	const Entry *find(const void *owner, lua_State *thread) const;
+	void compute_config(lua_State *thread, int& mask, int& count) const;
+	void install(lua_State *thread) const;
+	void install_all(lua_State *thread) const;
+
+	static void hook(lua_State *L, lua_Debug *ar);
+};
+
+}
+
+#endif  // __UTILS_LUA_HOOK_DISPATCHER_HPP__
@@ -0,0 +1,305 @@
+/**
+ * Copyright (C) 2026 Gil Barbosa Reis.
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the “Software”), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ * of the Software, and to permit persons to whom the Software is furnished to do
+ * so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#include "LuaJitTraceDiagnostics.hpp"
+
+#include <cstring>
+
+namespace luagdextension {
+
+#ifdef LUAJIT
+// Pushes a jit submodule, or nil if it is not available
+static void push_jit_module(lua_State *L, const char *name) {
+	lua_getfield(L, LUA_REGISTRYINDEX, "_LOADED");
+	lua_getfield(L, -1, name);
+	lua_remove(L, -2);
+	if (lua_istable(L, -1)) {
+		return;
+	}
+	lua_pop(L, 1);
+
+	// "jit.util" is preloaded by the jit library, Lua submodules like "jit.vmdef" need `require`
+	lua_getfield(L, LUA_REGISTRYINDEX, "_PRELOAD");
+	if (lua_istable(L, -1)) {
+		lua_getfield(L, -1, name);
+		lua_remove(L, -2);
+	}
+	if (!lua_isfunction(L, -1)) {
+		lua_pop(L, 1);
+		lua_getglobal(L, "require");
+	}
+	if (lua_isfunction(L, -1)) {
+		lua_pushstring(L, name);
+		if (lua_pcall(L, 1, 1, 0) == LUA_OK && lua_istable(L, -1)) {
+			return;
+		}
+	}
+	lua_pop(L, 1);
+	lua_pushnil(L);
+}
+
+// Calls `jit.util.funcinfo` stored in upvalue 2, pushing its result
+static void push_funcinfo(lua_State *L, int func_index, int pc_index) {
+	lua_pushvalue(L, lua_upvalueindex(2));
+	lua_pushvalue(L, func_index);
+	if (pc_index) {
+		lua_pushvalue(L, pc_index);
+	}
+	lua_call(L, pc_index ? 2 : 1, 1);
+}
+
+static String get_info_string(lua_State *L, int table_index, const char *key) {
+	lua_getfield(L, table_index, key);
+	String value = lua_isstring(L, -1) ? String::utf8(lua_tostring(L, -1)) : String();
+	lua_pop(L, 1);
+	return value;
+}
+
+// Gets the abort reason format for a trace error number from `jit.vmdef.traceerr` stored in upvalue 3, like `jit.dump` does.
+// Returns an empty string if "jit.vmdef" is not available.
+static String get_trace_error_format(lua_State *L, int error) {
+	String format;
+	if (lua_istable(L, lua_upvalueindex(3))) {
+		lua_getfield(L, lua_upvalueindex(3), "traceerr");
+		if (lua_istable(L, -1)) {
+			lua_rawgeti(L, -1, error);
+			if (lua_isstring(L, -1)) {
+				format = String::utf8(lua_tostring(L, -1));
+			}
+			lua_pop(L, 1);
+		}
+		lua_pop(L, 1);
+	}
+	return format;
+}
+
+// Formats the function or number passed as extra info to abort events, like `jit.dump` does
+static String format_abort_info(lua_State *L, int index, bool is_bytecode) {
+	switch (lua_type(L, index)) {
+		case LUA_TFUNCTION: {
+			push_funcinfo(L, index, 0);
+			String result = get_info_string(L, -1, "loc");
+			if (result.is_empty()) {
+				lua_getfield(L, -1, "ffid");
+				lua_getfield(L, -2, "addr");
+				if (lua_isnumber(L, -2)) {
+					int ffid = lua_tointeger(L, -2);
+					result = vformat("builtin#%d", ffid);
+					if (lua_istable(L, lua_upvalueindex(3))) {
+						lua_getfield(L, lua_upvalueindex(3), "ffnames");
+						lua_rawgeti(L, -1, ffid);
+						if (lua_isstring(L, -1)) {
+							result = String::utf8(lua_tostring(L, -1));
+						}
+						lua_pop(L, 2);
+					}
+				}
+				else if (lua_isnumber(L, -1)) {
+					result = "C:" + String::num_uint64((uint64_t) lua_tonumber(L, -1), 16);
+				}
+				lua_pop(L, 2);
+			}
+			lua_pop(L, 1);
+			return result.is_empty() ? String("?") : result;
+		}
+
+		case LUA_TNUMBER:
+			if (is_bytecode && lua_istable(L, lua_upvalueindex(3))) {
+				String bcnames = get_info_string(L, lua_upvalueindex(3), "bcnames");
+				return bcnames.substr(lua_tointeger(L, index) * 6, 6).strip_edges();
+			}
+			return String::num_int64(lua_tointeger(L, index));
+
+		default: {
+			const char *str = lua_tostring(L, index);
+			return str ? String::utf8(str) : String("?");
+		}
+	}
+}
+#endif
+
+LuaJitTraceDiagnostics::~LuaJitTraceDiagnostics() {
+	stop();
+}
+
+void LuaJitTraceDiagnostics::start(lua_State *L) {
+	ERR_FAIL_COND_MSG(L == nullptr, "Lua state cannot be null");
+#ifdef LUAJIT
+	L = sol::main_thread(L, L);
+	ERR_FAIL_COND_MSG(this->L != nullptr && this->L != L, "JIT trace diagnostics are already running for another Lua state");
+	if (this->L == L) {
+		return;
+	}
+
+	lua_getfield(L, LUA_REGISTRYINDEX, "_LOADED");
+	lua_getfield(L, -1, "jit");
+	lua_remove(L, -2);
+	if (!lua_istable(L, -1)) {
+		lua_pop(L, 1);
+		ERR_FAIL_MSG("JIT library is not opened");
+	}
+
+	lua_getfield(L, -1, "attach");
+	lua_pushlightuserdata(L, this);
+	push_jit_module(L, "jit.util");
+	if (!lua_istable(L, -1)) {
+		lua_pop(L, 4);
+		ERR_FAIL_MSG("jit.util module is not available");
+	}
+	lua_getfield(L, -1, "funcinfo");
+	lua_remove(L, -2);
+	// Only used for naming abort reasons, builtins and bytecodes, so it is optional
+	push_jit_module(L, "jit.vmdef");
+	lua_pushcclosure(L, trace_event, 3);
+	lua_pushvalue(L, -1);
+	callback_ref = luaL_ref(L, LUA_REGISTRYINDEX);
+	lua_pushstring(L, "trace");
+	lua_call(L, 2, 0);
+	lua_pop(L, 1);
+
+	this->L = L;
+#else
+	ERR_FAIL_MSG("JIT trace diagnostics are only supported in LuaJIT");
+#endif
+}
+
+void LuaJitTraceDiagnostics::stop() {
+	if (L == nullptr) {
+		return;
+	}
+
+#ifdef LUAJIT
+	// `jit.attach(callback)` without events detaches it
+	lua_getfield(L, LUA_REGISTRYINDEX, "_LOADED");
+	lua_getfield(L, -1, "jit");
+	if (lua_istable(L, -1)) {
+		lua_getfield(L, -1, "attach");
+		lua_rawgeti(L, LUA_REGISTRYINDEX, callback_ref);
+		lua_call(L, 1, 0);
+	}
+	lua_pop(L, 2);
+	luaL_unref(L, LUA_REGISTRYINDEX, callback_ref);
+#endif
+	callback_ref = LUA_NOREF;
+	L = nullptr;
+}
+
+void LuaJitTraceDiagnostics::clear() {
+	aborts.clear();
+	traces_started = 0;
+	traces_completed = 0;
+	traces_aborted = 0;
+	flushes = 0;
+}
+
+bool LuaJitTraceDiagnostics::is_running() const {
+	return L != nullptr;
+}
+
+Dictionary LuaJitTraceDiagnostics::get_aborts() const {
+	Dictionary result;
+	for (const KeyValue<String, HashMap<String, int64_t>>& location : aborts) {
+		Dictionary reasons;
+		for (const KeyValue<String, int64_t>& reason : location.value) {
+			reasons[reason.key] = reason.value;
+		}
+		result[location.key] = reasons;
+	}
+	return result;
+}
+
+Dictionary LuaJitTraceDiagnostics::get_stats() const {
+	Dictionary stats;
+	stats["traces_started"] = traces_started;
+	stats["traces_completed"] = traces_completed;
+	stats["traces_aborted"] = traces_aborted;
+	stats["flushes"] = flushes;
+	return stats;
+}
+
+#ifdef LUAJIT
+void LuaJitTraceDiagnostics::record_abort(lua_State *L) {
+	// Abort events are called with (what, trace, func, pc, error, info)
+	String location = "?";
+	if (lua_isfunction(L, 3)) {
+		push_funcinfo(L, 3, 4);
+		String source = get_info_string(L, -1, "source");
+		if (source.begins_with("@") || source.begins_with("=")) {
+			lua_getfield(L, -1, "currentline");
+			location = source.substr(1) + ":" + String::num_int64(lua_tointeger(L, -1));
+			lua_pop(L, 1);
+		}
+		else {
+			location = get_info_string(L, -1, "loc");
+		}
+		lua_pop(L, 1);
+	}
+
+	String reason;
+	if (lua_type(L, 5) == LUA_TNUMBER) {
+		int error = lua_tointeger(L, 5);
+		String format = get_trace_error_format(L, error);
+		if (!format.is_empty()) {
+			bool is_bytecode = format.contains("bytecode");
+			String info = format.contains("%") ? format_abort_info(L, 6, is_bytecode) : String();
+			reason = format.replace("%d", info).replace("%s", info);
+		}
+		else {
+			reason = vformat("trace error %d", error);
+		}
+	}
+	else {
+		reason = format_abort_info(L, 5, false);
+	}
+
+	HashMap<String, int64_t>& reasons = aborts[location];
+	if (int64_t *count = reasons.getptr(reason)) {
+		(*count)++;
+	}
+	else {
+		reasons.insert(reason, 1);
+	}
+}
+
+int LuaJitTraceDiagnostics::trace_event(lua_State *L) {
+	LuaJitTraceDiagnostics *diagnostics = (LuaJitTraceDiagnostics *) lua_touserdata(L, lua_upvalueindex(1));
+	const char *what = lua_tostring(L, 1);
+	if (what == nullptr) {
+		return 0;
+	}
+	else if (strcmp(what, "start") == 0) {
+		diagnostics->traces_started++;
+	}
+	else if (strcmp(what, "stop") == 0) {
+		diagnostics->traces_completed++;
+	}
+	else if (strcmp(what, "abort") == 0) {
+		diagnostics->traces_aborted++;
+		diagnostics->record_abort(L);
+	}
+	else if (strcmp(what, "flush") == 0) {
+		diagnostics->flushes++;
+	}
+	return 0;
+}
+#endif
+
+}
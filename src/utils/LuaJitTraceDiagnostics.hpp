@@ -0,0 +1,73 @@
+/**
+ * Copyright (C) 2026 Gil Barbosa Reis.
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the “Software”), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ * of the Software, and to permit persons to whom the Software is furnished to do
+ * so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#ifndef __UTILS_LUA_JIT_TRACE_DIAGNOSTICS_HPP__
+#define __UTILS_LUA_JIT_TRACE_DIAGNOSTICS_HPP__
+
+#include "custom_sol.hpp"
+
+#include <godot_cpp/templates/hash_map.hpp>
+#include <godot_cpp/variant/dictionary.hpp>
+
+using namespace godot;
+
+namespace luagdextension {
+
+/**
+ * LuaJIT trace event collector, attached with `jit.attach`.
+ *
+ * Trace aborts are counted natively per source location and reason,
+ * with locations resolved by `jit.util.funcinfo`.
+ * Only supported in LuaJIT, starting it in other runtimes fails with an error.
+ */
+class LuaJitTraceDiagnostics {
+public:
+	~LuaJitTraceDiagnostics();
+
+	void start(lua_State *L);
+	void stop();
+	void clear();
+	bool is_running() const;
+
+	// { "source:line": { reason: count } }
+	Dictionary get_aborts() const;
+	// { traces_started, traces_completed, traces_aborted, flushes }
+	Dictionary get_stats() const;
+
+private:
+	lua_State *L = nullptr;
+	int callback_ref = LUA_NOREF;
+	HashMap<String, HashMap<String, int64_t>> aborts;
+	int64_t traces_started = 0;
+	int64_t traces_completed = 0;
+	int64_t traces_aborted = 0;
+	int64_t flushes = 0;
+
+#ifdef LUAJIT
+	void record_abort(lua_State *L);
+
+	static int trace_event(lua_State *L);
+#endif
+};
+
+}
+
+#endif  // __UTILS_LUA_JIT_TRACE_DIAGNOSTICS_HPP__
@@ -0,0 +1,171 @@
+/**
+ * Copyright (C) 2026 Gil Barbosa Reis.
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the “Software”), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ * of the Software, and to permit persons to whom the Software is furnished to do
+ * so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#include "LuaPoolAllocator.hpp"
+
+#include <cstring>
+
+#include <godot_cpp/core/memory.hpp>
+
+namespace luagdextension {
+
+LuaPoolAllocator::~LuaPoolAllocator() {
+	while (chunks) {
+		Chunk *next = chunks->next;
+		memfree(chunks);
+		chunks = next;
+	}
+}
+
+void *LuaPoolAllocator::reallocate(void *ptr, size_t old_size, size_t new_size) {
+	// When `ptr` is NULL, Lua passes the type of the object being created in `old_size`
+	if (ptr == nullptr) {
+		old_size = 0;
+	}
+	bool old_is_small = old_size > 0 && old_size <= MAX_SMALL_SIZE;
+
+	if (new_size == 0) {
+		if (old_is_small) {
+			free_small(ptr, old_size);
+		}
+		else if (ptr != nullptr) {
+			memfree(ptr);
+		}
+		return nullptr;
+	}
+
+	if (new_size <= MAX_SMALL_SIZE) {
+		if (old_is_small && size_class(old_size) == size_class(new_size)) {
+			in_place_reallocations++;
+			requested_bytes += new_size;
+			requested_bytes -= old_size;
+			return ptr;
+		}
+
+		void *new_ptr = allocate_small(new_size);
+		if (new_ptr && ptr) {
+			memcpy(new_ptr, ptr, MIN(old_size, new_size));
+			if (old_is_small) {
+				free_small(ptr, old_size);
+			}
+			else {
+				memfree(ptr);
+			}
+		}
+		return new_ptr;
+	}
+	else {
+		large_allocations++;
+		if (!old_is_small) {
+			return memrealloc(ptr, new_size);
+		}
+
+		void *new_ptr = memalloc(new_size);
+		if (new_ptr) {
+			memcpy(new_ptr, ptr, old_size);
+			free_small(ptr, old_size);
+		}
+		return new_ptr;
+	}
+}
+
+Dictionary LuaPoolAllocator::get_stats() const {
+	uint64_t reserved_bytes = chunk_count * CHUNK_SIZE;
+
+	Dictionary stats;
+	stats["small_allocations"] = small_allocations;
+	stats["pool_hits"] = pool_hits;
+	stats["hit_rate"] = small_allocations > 0 ? (double) pool_hits / small_allocations : 0.0;
+	stats["in_place_reallocations"] = in_place_reallocations;
+	stats["large_allocations"] = large_allocations;
+	stats["chunk_count"] = chunk_count;
+	stats["reserved_bytes"] = reserved_bytes;
+	stats["used_bytes"] = used_bytes;
+	stats["requested_bytes"] = requested_bytes;
+	stats["fragmentation"] = reserved_bytes > 0 ? 1.0 - (double) requested_bytes / reserved_bytes : 0.0;
+	return stats;
+}
+
+void *LuaPoolAllocator::allocate_small(size_t size) {
+	size_t cls = size_class(size);
+	size_t block_size = size_class_bytes(cls);
+
+	void *block;
+	if (FreeBlock *free_block = free_lists[cls]) {
+		free_lists[cls] = free_block->next;
+		block = free_block;
+		pool_hits++;
+	}
+	else {
+		if ((size_t)(bump_end - bump_ptr) < block_size && !allocate_chunk()) {
+			return nullptr;
+		}
+		block = bump_ptr;
+		bump_ptr += block_size;
+	}
+
+	small_allocations++;
+	used_bytes += block_size;
+	requested_bytes += size;
+	return block;
+}
+
+void LuaPoolAllocator::free_small(void *ptr, size_t size) {
+	size_t cls = size_class(size);
+	FreeBlock *block = (FreeBlock *) ptr;
+	block->next = free_lists[cls];
+	free_lists[cls] = block;
+
+	used_bytes -= size_class_bytes(cls);
+	requested_bytes -= size;
+}
+
+bool LuaPoolAllocator::allocate_chunk() {
+	Chunk *chunk = (Chunk *) memalloc(CHUNK_SIZE);
+	if (chunk == nullptr) {
+		return false;
+	}
+
+	// Recycle the remaining bytes of the current chunk instead of wasting them
+	if (size_t remaining = bump_end - bump_ptr; remaining >= SIZE_CLASS_GRANULARITY) {
+		size_t cls = size_class(remaining - SIZE_CLASS_GRANULARITY + 1);
+		FreeBlock *block = (FreeBlock *) bump_ptr;
+		block->next = free_lists[cls];
+		free_lists[cls] = block;
+	}
+
+	chunk->next = chunks;
+	chunks = chunk;
+	chunk_count++;
+	bump_ptr = (uint8_t *) chunk + sizeof(Chunk);
+	bump_end = (uint8_t *) chunk + CHUNK_SIZE;
+	return true;
+}
+
+size_t LuaPoolAllocator::size_class(size_t size) {
+	return (size + SIZE_CLASS_GRANULARITY - 1) / SIZE_CLASS_GRANULARITY - 1;
+}
+
+size_t LuaPoolAllocator::size_class_bytes(size_t size_class) {
+	return (size_class + 1) * SIZE_CLASS_GRANULARITY;
+}
+
+}
@@ -0,0 +1,90 @@
+/**
+ * Copyright (C) 2026 Gil Barbosa Reis.
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the “Software”), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ * of the Software, and to permit persons to whom the Software is furnished to do
+ * so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#ifndef __UTILS_LUA_POOL_ALLOCATOR_HPP__
+#define __UTILS_LUA_POOL_ALLOCATOR_HPP__
+
+#include <cstddef>
+#include <cstdint>
+
+#include <godot_cpp/variant/dictionary.hpp>
+
+using namespace godot;
+
+namespace luagdextension {
+
+/**
+ * Lua allocator with size-class free lists for small blocks.
+ *
+ * Blocks up to MAX_SMALL_SIZE bytes are carved from CHUNK_SIZE chunks and
+ * recycled through one free list per size class.
+ * Bigger blocks are passed through to Godot's memory functions.
+ *
+ * Lua always passes the original block size when reallocating or freeing
+ * blocks, so no per-block headers are necessary.
+ * Not thread-safe: each LuaState has its own allocator.
+ */
+class LuaPoolAllocator {
+public:
+	static constexpr size_t MAX_SMALL_SIZE = 256;
+	static constexpr size_t SIZE_CLASS_GRANULARITY = 8;
+	static constexpr size_t SIZE_CLASS_COUNT = MAX_SMALL_SIZE / SIZE_CLASS_GRANULARITY;
+	static constexpr size_t CHUNK_SIZE = 32 * 1024;
+
+	LuaPoolAllocator() = default;
+	~LuaPoolAllocator();
+
+	void *reallocate(void *ptr, size_t old_size, size_t new_size);
+	Dictionary get_stats() const;
+
+private:
+	struct FreeBlock {
+		FreeBlock *next;
+	};
+	struct alignas(16) Chunk {
+		Chunk *next;
+	};
+
+	FreeBlock *free_lists[SIZE_CLASS_COUNT] = {};
+	Chunk *chunks = nullptr;
+	uint8_t *bump_ptr = nullptr;
+	uint8_t *bump_end = nullptr;
+
+	// Statistics
+	uint64_t small_allocations = 0;
+	uint64_t pool_hits = 0;
+	uint64_t in_place_reallocations = 0;
+	uint64_t large_allocations = 0;
+	uint64_t chunk_count = 0;
+	uint64_t used_bytes = 0;
+	uint64_t requested_bytes = 0;
+
+	void *allocate_small(size_t size);
+	void free_small(void *ptr, size_t size);
+	bool allocate_chunk();
+
+	static size_t size_class(size_t size);
+	static size_t size_class_bytes(size_t size_class);
+};
+
+}
+
+#endif  // __UTILS_LUA_POOL_ALLOCATOR_HPP__
@@ -0,0 +1,94 @@
+/**
+ * Copyright (C) 2026 Gil Barbosa Reis.
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the “Software”), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ * of the Software, and to permit persons to whom the Software is furnished to do
+ * so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#ifndef __UTILS_SPSC_QUEUE_HPP__
+#define __UTILS_SPSC_QUEUE_HPP__
+
+#include <atomic>
+#include <cstdint>
+
+#include <godot_cpp/core/defs.hpp>
+#include <godot_cpp/templates/local_vector.hpp>
+
+using namespace godot;
+
+namespace luagdextension {
+
+/**
+ * Bounded lock-free queue for a single producer thread and a single consumer thread.
+ *
+ * Capacity is rounded up to a power of 2. `resize` must be called before the
+ * queue is shared between threads.
+ */
+template<typename T>
+class SPSCQueue {
+public:
+	void resize(uint32_t capacity) {
+		capacity = next_power_of_2(MAX(capacity, 1u));
+		slots.clear();
+		slots.resize(capacity);
+		mask = capacity - 1;
+		head.store(0);
+		tail.store(0);
+	}
+
+	// Returns false if the queue is full
+	bool push(const T& value) {
+		uint64_t current_tail = tail.load(std::memory_order_relaxed);
+		if (current_tail - head.load(std::memory_order_acquire) >= slots.size()) {
+			return false;
+		}
+		slots[current_tail & mask] = value;
+		tail.store(current_tail + 1, std::memory_order_release);
+		return true;
+	}
+
+	// Returns false if the queue is empty
+	bool pop(T& value) {
+		uint64_t current_head = head.load(std::memory_order_relaxed);
+		if (current_head == tail.load(std::memory_order_acquire)) {
+			return false;
+		}
+		value = slots[current_head & mask];
+		// Release the slot's contents right away instead of when it gets overwritten
+		slots[current_head & mask] = T();
+		head.store(current_head + 1, std::memory_order_release);
+		return true;
+	}
+
+	bool is_empty() const {
+		return head.load(std::memory_order_acquire) == tail.load(std::memory_order_acquire);
+	}
+
+	uint32_t size() const {
+		return tail.load(std::memory_order_acquire) - head.load(std::memory_order_acquire);
+	}
+
+private:
+	LocalVector<T> slots;
+	uint64_t mask = 0;
+	std::atomic<uint64_t> head = 0;
+	std::atomic<uint64_t> tail = 0;
+};
+
+}
+
+#endif  // __UTILS_SPSC_QUEUE_HPP__
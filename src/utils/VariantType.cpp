@@ -24,6 +24,7 @@
 #include "Class.hpp"
 #include "LuaCallable.hpp"
 #include "VariantArguments.hpp"
+#include "builtin_method_binds.hpp"
 #include "convert_godot_lua.hpp"
 #include "method_bind_impl.hpp"
 #include "../generated/variant_type_constants.hpp"
@@ -186,6 +187,10 @@ sol::object VariantType::__index(sol::this_state L, const VariantType& type, con
 			return to_lua(L, constant);
 		}
 
+		if (BuiltinMethodFunc builtin_method = get_builtin_method_bind(type.get_type(), key_str)) {
+			return sol::make_object(L, VariantTypeMethodBind(type, key_str, builtin_method));
+		}
+
 		Variant empty = type.construct_default();
 		if (empty.has_method(key_str)) {
 			return sol::make_object(L, VariantTypeMethodBind(type, key_str));
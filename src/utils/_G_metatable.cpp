@@ -49,7 +49,7 @@ sol::object __index(sol::this_state state, sol::global_table _G, sol::stack_obje
 			Variant singleton = engine->get_singleton(class_name);
 			return _G[key] = to_lua(state, singleton);
 		}
-		else if (Variant named_global = LuaScriptLanguage::get_singleton()->get_named_globals().get(class_name, nullptr); named_global.get_type() != Variant::NIL) {
+		else if (Variant named_global = LuaScriptLanguage::get_singleton()->get_named_global(class_name); named_global.get_type() != Variant::NIL) {
 			return _G[key] = to_lua(state, named_global);
 		}
 	}
@@ -0,0 +1,242 @@
+/**
+ * Copyright (C) 2026 Gil Barbosa Reis.
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the “Software”), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ * of the Software, and to permit persons to whom the Software is furnished to do
+ * so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#include "builtin_method_binds.hpp"
+
+#include "convert_godot_lua.hpp"
+#include "ffi_math.hpp"
+#include "performance_monitors.hpp"
+#include "string_literal.hpp"
+#include "../LuaTracer.hpp"
+
+#include <godot_cpp/core/type_info.hpp>
+#include <godot_cpp/templates/hash_map.hpp>
+
+#include <array>
+#include <atomic>
+#include <mutex>
+#include <tuple>
+#include <utility>
+
+namespace luagdextension {
+
+/// Returns the Variant stored in the userdata at `index`, or nullptr if it's not a Variant of type `type`
+static Variant *get_variant_userdata(lua_State *L, int index, Variant::Type type) {
+	if (lua_type(L, index) != LUA_TUSERDATA || !sol::stack::check<Variant>(L, index, sol::no_panic)) {
+		return nullptr;
+	}
+	Variant& variant = sol::stack::get<Variant&>(L, index);
+	return variant.get_type() == type ? &variant : nullptr;
+}
+
+/// Reads the argument at `index` of the Lua stack without converting it to Variant.
+/// `pointer` is set either to `storage` or to the value stored inside a Variant userdata, which avoids copying it.
+template<typename T>
+static bool get_builtin_argument(lua_State *L, int index, T& storage, GDExtensionConstTypePtr& pointer) {
+	constexpr Variant::Type type = GetTypeInfo<T>::VARIANT_TYPE;
+	if (Variant *variant = get_variant_userdata(L, index, type)) {
+		static GDExtensionVariantGetInternalPtrFunc getter = gdextension_interface::get_variant_get_internal_ptr_func((GDExtensionVariantType) type);
+		pointer = getter(variant->_native_ptr());
+		return true;
+	}
+#ifdef LUAJIT
+	if (lua_type(L, index) == LUAJIT_TCDATA) {
+		Variant variant;
+		if (!ffi_math_to_variant(L, index, variant) || variant.get_type() != type) {
+			return false;
+		}
+		storage = variant;
+		pointer = &storage;
+		return true;
+	}
+#endif
+	return false;
+}
+
+template<>
+bool get_builtin_argument(lua_State *L, int index, double& storage, GDExtensionConstTypePtr& pointer) {
+	if (lua_type(L, index) != LUA_TNUMBER) {
+		return false;
+	}
+	int isnum;
+	storage = lua_tonumberx(L, index, &isnum);
+	pointer = &storage;
+	return isnum;
+}
+
+template<>
+bool get_builtin_argument(lua_State *L, int index, int64_t& storage, GDExtensionConstTypePtr& pointer) {
+	if (lua_type(L, index) != LUA_TNUMBER) {
+		return false;
+	}
+#if LUA_VERSION_NUM >= 503
+	int isnum;
+	storage = lua_tointegerx(L, index, &isnum);
+	if (!isnum) {
+		return false;
+	}
+#else
+	lua_Number number = lua_tonumber(L, index);
+	storage = (int64_t) number;
+	if (storage != number) {
+		return false;
+	}
+#endif
+	pointer = &storage;
+	return true;
+}
+
+template<>
+bool get_builtin_argument(lua_State *L, int index, bool& storage, GDExtensionConstTypePtr& pointer) {
+	if (lua_type(L, index) != LUA_TBOOLEAN) {
+		return false;
+	}
+	storage = lua_toboolean(L, index);
+	pointer = &storage;
+	return true;
+}
+
+template<>
+bool get_builtin_argument(lua_State *L, int index, String& storage, GDExtensionConstTypePtr& pointer) {
+	if (lua_type(L, index) == LUA_TSTRING) {
+		size_t length;
+		const char *str = lua_tolstring(L, index, &length);
+		storage = String::utf8(str, length);
+		pointer = &storage;
+		return true;
+	}
+	if (Variant *variant = get_variant_userdata(L, index, Variant::STRING)) {
+		static GDExtensionVariantGetInternalPtrFunc getter = gdextension_interface::get_variant_get_internal_ptr_func(GDEXTENSION_VARIANT_TYPE_STRING);
+		pointer = getter(variant->_native_ptr());
+		return true;
+	}
+	if (Variant *variant = get_variant_userdata(L, index, Variant::STRING_NAME)) {
+		storage = *variant;
+		pointer = &storage;
+		return true;
+	}
+	return false;
+}
+
+template<typename T>
+static void push_builtin_return(lua_State *L, const T& value) {
+	lua_push(L, Variant(value));
+}
+
+template<>
+void push_builtin_return(lua_State *L, const double& value) {
+	lua_pushnumber(L, value);
+}
+
+template<>
+void push_builtin_return(lua_State *L, const int64_t& value) {
+	lua_pushinteger(L, value);
+}
+
+template<>
+void push_builtin_return(lua_State *L, const bool& value) {
+	lua_pushboolean(L, value);
+}
+
+template<>
+void push_builtin_return(lua_State *L, const String& value) {
+	sol::stack::push(L, value);
+}
+
+// Used when arguments don't match the typed binding, for example when default arguments are omitted
+static int call_builtin_method_variant(lua_State *L, int self_index, const StringName& method) {
+	Variant self = to_variant(L, self_index);
+	sol::object result = variant_call_string_name(L, self, method, sol::variadic_args(L, self_index + 1));
+	result.push(L);
+	return 1;
+}
+
+template<Variant::Type SelfType, typename Self, StringLiteral method_name, int64_t method_hash, typename RetType, typename... Args, size_t... I>
+static int call_builtin_method_impl(lua_State *L, int self_index, std::index_sequence<I...>) {
+	static GDExtensionPtrBuiltInMethod method = gdextension_interface::variant_get_ptr_builtin_method((GDExtensionVariantType) SelfType, StringName(method_name)._native_ptr(), method_hash);
+
+	Self self;
+	GDExtensionConstTypePtr self_pointer;
+	std::tuple<Args...> args;
+	std::array<GDExtensionConstTypePtr, sizeof...(Args)> arg_pointers;
+	if (method == nullptr
+		|| lua_gettop(L) - self_index != (int) sizeof...(Args)
+		|| !get_builtin_argument(L, self_index, self, self_pointer)
+		|| !(get_builtin_argument(L, self_index + 1 + I, std::get<I>(args), arg_pointers[I]) && ...)) {
+		return call_builtin_method_variant(L, self_index, StringName(method_name));
+	}
+
+	godot_calls_from_lua.fetch_add(1, std::memory_order_relaxed);
+	LuaTracer::Scope trace_scope(LuaTracer::LUA_TO_GODOT, "call_builtin_method", nullptr);
+	if constexpr (std::is_void_v<RetType>) {
+		// Only const methods are bound, so `self` is never modified
+		method((GDExtensionTypePtr) self_pointer, arg_pointers.data(), nullptr, sizeof...(Args));
+		return 0;
+	}
+	else {
+		RetType ret;
+		method((GDExtensionTypePtr) self_pointer, arg_pointers.data(), &ret, sizeof...(Args));
+		push_builtin_return(L, ret);
+		return 1;
+	}
+}
+
+template<Variant::Type SelfType, typename Self, StringLiteral method_name, int64_t method_hash, typename RetType, typename... Args>
+static int call_builtin_method(lua_State *L, int self_index) {
+	return call_builtin_method_impl<SelfType, Self, method_name, method_hash, RetType, Args...>(L, self_index, std::index_sequence_for<Args...>());
+}
+
+using BuiltinMethodMap = HashMap<StringName, BuiltinMethodFunc>;
+
+}
+
+#include "../generated/builtin_method_binds.hpp"
+
+namespace luagdextension {
+
+// Builtin methods may be looked up from Lua states running in different threads
+static std::mutex builtin_methods_mutex;
+// One map per Variant type, filled on first use
+static std::atomic<BuiltinMethodMap *> builtin_methods;
+
+BuiltinMethodFunc get_builtin_method_bind(Variant::Type type, const StringName& method) {
+	BuiltinMethodMap *methods = builtin_methods.load(std::memory_order_acquire);
+	if (methods == nullptr) {
+		std::lock_guard lock(builtin_methods_mutex);
+		methods = builtin_methods.load(std::memory_order_relaxed);
+		if (methods == nullptr) {
+			methods = memnew_arr(BuiltinMethodMap, Variant::VARIANT_MAX);
+			register_builtin_method_binds(methods);
+			builtin_methods.store(methods, std::memory_order_release);
+		}
+	}
+	const BuiltinMethodFunc *function = methods[type].getptr(method);
+	return function ? *function : nullptr;
+}
+
+void free_builtin_method_binds() {
+	std::lock_guard lock(builtin_methods_mutex);
+	if (BuiltinMethodMap *methods = builtin_methods.exchange(nullptr)) {
+		memdelete_arr(methods);
+	}
+}
+
+}
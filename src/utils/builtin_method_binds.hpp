@@ -0,0 +1,51 @@
+/**
+ * Copyright (C) 2026 Gil Barbosa Reis.
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the “Software”), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ * of the Software, and to permit persons to whom the Software is furnished to do
+ * so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#ifndef __UTILS_BUILTIN_METHOD_BINDS_HPP__
+#define __UTILS_BUILTIN_METHOD_BINDS_HPP__
+
+#include "custom_sol.hpp"
+
+#include <godot_cpp/variant/variant.hpp>
+
+using namespace godot;
+
+namespace luagdextension {
+
+/**
+ * Calls a builtin method with `self` at `self_index` of the Lua stack and arguments above it, up to the stack top.
+ * Pushes the returned value and returns the number of pushed values, like a lua_CFunction.
+ */
+using BuiltinMethodFunc = int (*)(lua_State *L, int self_index);
+
+/**
+ * Returns a function that calls the builtin method with typed arguments read directly from the Lua stack,
+ * or nullptr if the method has no typed binding.
+ * Bindings are generated from extension_api.json for const methods of math types and String.
+ */
+BuiltinMethodFunc get_builtin_method_bind(Variant::Type type, const StringName& method);
+
+// Frees the builtin method binding tables, must be called before the extension is unloaded
+void free_builtin_method_binds();
+
+}
+
+#endif  // __UTILS_BUILTIN_METHOD_BINDS_HPP__
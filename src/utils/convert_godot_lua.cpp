@@ -26,6 +26,7 @@
 #include "../LuaFunction.hpp"
 #include "../LuaLightUserdata.hpp"
 #include "../LuaTable.hpp"
+#include "../LuaTracer.hpp"
 #include "../LuaUserdata.hpp"
 #include "../script-language/LuaScriptInstance.hpp"
 #include "Class.hpp"
@@ -33,8 +34,10 @@
 #include "VariantArguments.hpp"
 #include "convert_godot_std.hpp"
 #include "extra_utility_functions.hpp"
+#include "ffi_math.hpp"
 #include "load_fileaccess.hpp"
 #include "method_bind_impl.hpp"
+#include "performance_monitors.hpp"
 #include "stack_top_checker.hpp"
 
 #include <godot_cpp/core/error_macros.hpp>
@@ -50,6 +53,18 @@ namespace luagdextension {
 
 template<typename ref_t>
 Variant to_variant(const sol::basic_object<ref_t>& object) {
+#ifdef LUAJIT
+	if ((int) object.get_type() == LUAJIT_TCDATA) {
+		lua_State *L = object.lua_state();
+		object.push(L);
+		Variant result;
+		bool converted = ffi_math_to_variant(L, -1, result);
+		lua_pop(L, 1);
+		if (converted) {
+			return result;
+		}
+	}
+#endif
 	switch (object.get_type()) {
 		case sol::type::boolean:
 			return object.template as<bool>();
@@ -199,6 +214,27 @@ sol::stack_object lua_push(lua_State *lua_state, const Variant& value) {
 				}
 			}
 			goto push_as_variant;
+
+#ifdef LUAJIT
+		case Variant::VECTOR2:
+		case Variant::VECTOR2I:
+		case Variant::RECT2:
+		case Variant::VECTOR3:
+		case Variant::VECTOR3I:
+		case Variant::TRANSFORM2D:
+		case Variant::VECTOR4:
+		case Variant::VECTOR4I:
+		case Variant::PLANE:
+		case Variant::QUATERNION:
+		case Variant::AABB:
+		case Variant::BASIS:
+		case Variant::TRANSFORM3D:
+		case Variant::COLOR:
+			if (ffi_math_push(lua_state, value)) {
+				break;
+			}
+			goto push_as_variant;
+#endif
 			
 		case Variant::CALLABLE:
 			if (LuaState *gdlua = LuaState::find_lua_state(lua_state); gdlua->are_libraries_opened(LuaState::GODOT_VARIANT)) {
@@ -270,6 +306,7 @@ sol::table to_table(sol::state_view& state, const Dictionary& dictionary) {
 static int callable_closure(lua_State *L) {
 	Callable callable = to_variant(L, lua_upvalueindex(1));
 	sol::variadic_args args(L, 1);
+	godot_calls_from_lua.fetch_add(1, std::memory_order_relaxed);
 	Variant result = callable.callv(VariantArguments(args).get_array());
 	lua_push(L, result);
 	return 1;
@@ -287,6 +324,7 @@ sol::protected_function to_lua_function(lua_State *L, const Callable& callable)
 }
 
 Variant callable_call(const Callable& callable, const sol::variadic_args& args) {
+	godot_calls_from_lua.fetch_add(1, std::memory_order_relaxed);
 	return callable.callv(VariantArguments(args).get_array());
 }
 
@@ -295,6 +333,8 @@ sol::object variant_static_call_string_name(sol::this_state state, Variant::Type
 
 	Variant result;
 	GDExtensionCallError error;
+	godot_calls_from_lua.fetch_add(1, std::memory_order_relaxed);
+	LuaTracer::Scope trace_scope(LuaTracer::LUA_TO_GODOT, "variant_static_call_string_name", &method);
 	Variant::callp_static(type, method, variant_args.argv(), variant_args.argc(), result, error);
 	if (error.error != GDEXTENSION_CALL_OK) {
 		String message = String("Invalid static call to method '{0}' in type {1}").format(Array::make(method, Variant::get_type_name(type)));
@@ -307,6 +347,8 @@ sol::object variant_call_string_name(sol::this_state state, Variant& variant, co
 
 	Variant result;
 	GDExtensionCallError error;
+	godot_calls_from_lua.fetch_add(1, std::memory_order_relaxed);
+	LuaTracer::Scope trace_scope(LuaTracer::LUA_TO_GODOT, "variant_call_string_name", &method);
 	variant.callp(method, variant_args.argv(), variant_args.argc(), result, error);
 	if (error.error != GDEXTENSION_CALL_OK) {
 		String message = String("Invalid call to method '{0}' in object of type {1}").format(Array::make(method, get_type_name(variant)));
@@ -323,6 +365,8 @@ std::tuple<bool, sol::object> variant_pcall_string_name(sol::this_state state, V
 
 	Variant result;
 	GDExtensionCallError error;
+	godot_calls_from_lua.fetch_add(1, std::memory_order_relaxed);
+	LuaTracer::Scope trace_scope(LuaTracer::LUA_TO_GODOT, "variant_pcall_string_name", &method);
 	variant.callp(method, variant_args.argv(), variant_args.argc(), result, error);
 	if (error.error == GDEXTENSION_CALL_OK) {
 		return std::make_tuple(true, to_lua(state, result));
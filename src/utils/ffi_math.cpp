@@ -0,0 +1,173 @@
+/**
+ * Copyright (C) 2026 Gil Barbosa Reis.
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the “Software”), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ * of the Software, and to permit persons to whom the Software is furnished to do
+ * so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#ifdef LUAJIT
+
+#include "ffi_math.hpp"
+
+#include "convert_godot_lua.hpp"
+#include "../generated/ffi_math.h"
+
+#include <atomic>
+
+namespace luagdextension {
+
+static const char FFI_MATH_KEY[] = "_GDEXTENSION_FFI_MATH";
+
+// Set once any state requires "godot.ffi_math", so that pushing values skips the registry lookup until then
+static std::atomic<bool> ffi_math_loaded = false;
+
+#ifdef REAL_T_IS_DOUBLE
+	#define REAL_T_CTYPE "double"
+#else
+	#define REAL_T_CTYPE "float"
+#endif
+
+template<typename T>
+static void write_cdata(const Variant& value, void *data) {
+	*(T *) data = value;
+}
+
+template<typename T>
+static Variant read_cdata(const void *data) {
+	return *(const T *) data;
+}
+
+// Pushes a Variant userdata, bypassing cdata conversion. Used for Variant fallbacks in FFI metatypes.
+static int l_to_variant(lua_State *L) {
+	sol::stack::push_userdata(L, to_variant(L, 1));
+	return 1;
+}
+
+static int l_ffi_math_loader(lua_State *L) {
+	lua_getfield(L, LUA_REGISTRYINDEX, FFI_MATH_KEY);
+	if (lua_isnil(L, -1)) {
+		lua_pop(L, 1);
+		if (luaL_loadbuffer(L, ffi_math_lua, sizeof(ffi_math_lua) - 1, "=ffi_math") != LUA_OK) {
+			return lua_error(L);
+		}
+		lua_getfield(L, LUA_REGISTRYINDEX, "_LOADED");
+		lua_getfield(L, -1, "ffi");
+		lua_remove(L, -2);
+		lua_pushstring(L, REAL_T_CTYPE);
+		lua_pushcfunction(L, l_to_variant);
+		lua_call(L, 3, 1);
+		// FFI types can only be defined once per state, so keep them in the registry
+		lua_pushvalue(L, -1);
+		lua_setfield(L, LUA_REGISTRYINDEX, FFI_MATH_KEY);
+		ffi_math_loaded.store(true, std::memory_order_relaxed);
+	}
+	lua_getfield(L, -1, "module");
+	return 1;
+}
+
+void register_ffi_math(lua_State *L) {
+	sol::state_view state(L);
+	auto ffi = state.registry().traverse_get<sol::optional<sol::table>>("_LOADED", "ffi");
+	auto package = state.get<sol::optional<sol::table>>("package");
+	if (ffi && package) {
+		package->traverse_set("preload", "godot.ffi_math", l_ffi_math_loader);
+	}
+}
+
+bool ffi_math_push(lua_State *L, const Variant& value) {
+	if (!ffi_math_loaded.load(std::memory_order_relaxed)) {
+		return false;
+	}
+	lua_getfield(L, LUA_REGISTRYINDEX, FFI_MATH_KEY);
+	if (lua_isnil(L, -1)) {
+		lua_pop(L, 1);
+		return false;
+	}
+	lua_getfield(L, -1, "ctypes");
+	lua_rawgeti(L, -1, value.get_type());
+	if (lua_isnil(L, -1)) {
+		lua_pop(L, 3);
+		return false;
+	}
+	// Calling the ctype creates zero-filled cdata, which is then filled with the value's memory
+	lua_call(L, 0, 1);
+	void *data = (void *) lua_topointer(L, -1);
+	switch (value.get_type()) {
+		case Variant::VECTOR2: write_cdata<Vector2>(value, data); break;
+		case Variant::VECTOR2I: write_cdata<Vector2i>(value, data); break;
+		case Variant::RECT2: write_cdata<Rect2>(value, data); break;
+		case Variant::VECTOR3: write_cdata<Vector3>(value, data); break;
+		case Variant::VECTOR3I: write_cdata<Vector3i>(value, data); break;
+		case Variant::TRANSFORM2D: write_cdata<Transform2D>(value, data); break;
+		case Variant::VECTOR4: write_cdata<Vector4>(value, data); break;
+		case Variant::VECTOR4I: write_cdata<Vector4i>(value, data); break;
+		case Variant::PLANE: write_cdata<Plane>(value, data); break;
+		case Variant::QUATERNION: write_cdata<Quaternion>(value, data); break;
+		case Variant::AABB: write_cdata<AABB>(value, data); break;
+		case Variant::BASIS: write_cdata<Basis>(value, data); break;
+		case Variant::TRANSFORM3D: write_cdata<Transform3D>(value, data); break;
+		case Variant::COLOR: write_cdata<Color>(value, data); break;
+		default: break;
+	}
+	lua_replace(L, -3);
+	lua_pop(L, 1);
+	return true;
+}
+
+bool ffi_math_to_variant(lua_State *L, int index, Variant& result) {
+	if (!ffi_math_loaded.load(std::memory_order_relaxed)) {
+		return false;
+	}
+	lua_pushvalue(L, index);
+	lua_getfield(L, LUA_REGISTRYINDEX, FFI_MATH_KEY);
+	if (lua_isnil(L, -1)) {
+		lua_pop(L, 2);
+		return false;
+	}
+	lua_getfield(L, -1, "variant_type_of");
+	lua_pushvalue(L, -3);
+	lua_call(L, 1, 1);
+	if (lua_isnil(L, -1)) {
+		lua_pop(L, 3);
+		return false;
+	}
+	Variant::Type type = (Variant::Type) lua_tointeger(L, -1);
+	const void *data = lua_topointer(L, -3);
+	switch (type) {
+		case Variant::VECTOR2: result = read_cdata<Vector2>(data); break;
+		case Variant::VECTOR2I: result = read_cdata<Vector2i>(data); break;
+		case Variant::RECT2: result = read_cdata<Rect2>(data); break;
+		case Variant::VECTOR3: result = read_cdata<Vector3>(data); break;
+		case Variant::VECTOR3I: result = read_cdata<Vector3i>(data); break;
+		case Variant::TRANSFORM2D: result = read_cdata<Transform2D>(data); break;
+		case Variant::VECTOR4: result = read_cdata<Vector4>(data); break;
+		case Variant::VECTOR4I: result = read_cdata<Vector4i>(data); break;
+		case Variant::PLANE: result = read_cdata<Plane>(data); break;
+		case Variant::QUATERNION: result = read_cdata<Quaternion>(data); break;
+		case Variant::AABB: result = read_cdata<AABB>(data); break;
+		case Variant::BASIS: result = read_cdata<Basis>(data); break;
+		case Variant::TRANSFORM3D: result = read_cdata<Transform3D>(data); break;
+		case Variant::COLOR: result = read_cdata<Color>(data); break;
+		default: break;
+	}
+	lua_pop(L, 3);
+	return true;
+}
+
+}
+
+#endif  // LUAJIT
@@ -0,0 +1,50 @@
+/**
+ * Copyright (C) 2026 Gil Barbosa Reis.
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the “Software”), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ * of the Software, and to permit persons to whom the Software is furnished to do
+ * so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#ifndef __UTILS_FFI_MATH_HPP__
+#define __UTILS_FFI_MATH_HPP__
+
+#ifdef LUAJIT
+
+#include "custom_sol.hpp"
+
+#include <godot_cpp/variant/variant.hpp>
+
+using namespace godot;
+
+namespace luagdextension {
+
+// Type returned by `lua_type` for LuaJIT's FFI cdata, which is not defined in lua.h nor sol::type
+constexpr int LUAJIT_TCDATA = 10;
+
+// Registers the "godot.ffi_math" module in `package.preload`, if the FFI library is opened
+void register_ffi_math(lua_State *L);
+
+// After "godot.ffi_math" is required, math types are pushed to Lua as FFI cdata
+bool ffi_math_push(lua_State *L, const Variant& value);
+// Converts FFI cdata created by "godot.ffi_math" to Variant
+bool ffi_math_to_variant(lua_State *L, int index, Variant& result);
+
+}
+
+#endif  // LUAJIT
+
+#endif  // __UTILS_FFI_MATH_HPP__
@@ -23,14 +23,28 @@
 
 #include "VariantArguments.hpp"
 #include "convert_godot_lua.hpp"
+#include "extra_utility_functions.hpp"
+#include "object_method_binds.hpp"
+#include "performance_monitors.hpp"
 #include "string_names.hpp"
 #include "../LuaTable.hpp"
+#include "../LuaTracer.hpp"
 
 #include <godot_cpp/classes/class_db_singleton.hpp>
 #include <godot_cpp/variant/utility_functions.hpp>
 
 namespace luagdextension {
 
+// Calls a typed builtin method binding with the arguments already in the Lua stack
+static sol::object call_builtin_method_bind(lua_State *L, BuiltinMethodFunc builtin_method, const sol::stack_object& self) {
+	if (builtin_method(L, self.stack_index()) == 0) {
+		return sol::nil;
+	}
+	sol::object result(L, -1);
+	lua_pop(L, 1);
+	return result;
+}
+
 BaseMethodBind::BaseMethodBind(const StringName& method_name)
 	: method_name(method_name)
 {
@@ -53,6 +67,8 @@ sol::object ClassMethodBind::call(sol::this_state state, const sol::stack_object
 	Array var_args = VariantArguments(args).get_array();
 	var_args.push_front(get_method_name());
 	var_args.push_front(cls.get_name());
+	godot_calls_from_lua.fetch_add(1, std::memory_order_relaxed);
+	LuaTracer::Scope trace_scope(LuaTracer::LUA_TO_GODOT, "ClassMethodBind::call", &method_name);
 	return to_lua(state, ClassDBSingleton::get_singleton()->callv(string_names->class_call_static, var_args));
 }
 
@@ -88,9 +104,17 @@ void LuaScriptInstanceMethodBind::register_usertype(sol::state_view& state) {
 
 
 // VariantMethodBind
-VariantMethodBind::VariantMethodBind(const Variant& variant, const StringName& method_name)
+VariantMethodBind::VariantMethodBind(const Variant& variant, const StringName& method_name, GDExtensionMethodBindPtr method_bind)
+	: BaseMethodBind(method_name)
+	, variant(variant)
+	, method_bind(method_bind)
+{
+}
+
+VariantMethodBind::VariantMethodBind(const Variant& variant, const StringName& method_name, BuiltinMethodFunc builtin_method)
 	: BaseMethodBind(method_name)
 	, variant(variant)
+	, builtin_method(builtin_method)
 {
 }
 
@@ -101,6 +125,12 @@ Callable VariantMethodBind::to_callable() const {
 sol::object VariantMethodBind::call(sol::this_state state, const sol::stack_object& self, const sol::variadic_args& args) const {
 	Variant v = to_variant(self);
 	ERR_FAIL_COND_V_MSG(!UtilityFunctions::is_same(v, variant), sol::nil, String("To call methods in Lua, use ':' instead of '.': `variant:%s(...)`") % method_name);
+	if (builtin_method) {
+		return call_builtin_method_bind(state, builtin_method, self);
+	}
+	if (method_bind && is_instance_valid(v)) {
+		return object_method_bind_call(state, v, method_bind, method_name, args);
+	}
 	return variant_call_string_name(state, v, method_name, args);
 }
 
@@ -110,9 +140,10 @@ void VariantMethodBind::register_usertype(sol::state_view& state) {
 
 
 // VariantTypeMethodBind
-VariantTypeMethodBind::VariantTypeMethodBind(const VariantType& type, const StringName& method_name)
+VariantTypeMethodBind::VariantTypeMethodBind(const VariantType& type, const StringName& method_name, BuiltinMethodFunc builtin_method)
 	: BaseMethodBind(method_name)
 	, type(type)
+	, builtin_method(builtin_method)
 {
 }
 
@@ -123,6 +154,9 @@ sol::object VariantTypeMethodBind::call(sol::this_state state, const sol::stack_
 	else {
 		Variant v = to_variant(self);
 		ERR_FAIL_COND_V_MSG(v.get_type() != type.get_type(), sol::nil, String("Trying to call a %s method using a value of type %s") % Array::make(Variant::get_type_name(type.get_type()), Variant::get_type_name(v.get_type())));
+		if (builtin_method) {
+			return call_builtin_method_bind(state, builtin_method, self);
+		}
 		return variant_call_string_name(state, v, method_name, args);
 	}
 }
@@ -24,6 +24,7 @@
 
 #include "Class.hpp"
 #include "VariantType.hpp"
+#include "builtin_method_binds.hpp"
 #include "../script-language/LuaScriptInstance.hpp"
 
 namespace luagdextension {
@@ -78,7 +79,8 @@ protected:
 
 class VariantMethodBind : public BaseMethodBind {
 public:
-	VariantMethodBind(const Variant& variant, const StringName& method_name);
+	VariantMethodBind(const Variant& variant, const StringName& method_name, GDExtensionMethodBindPtr method_bind = nullptr);
+	VariantMethodBind(const Variant& variant, const StringName& method_name, BuiltinMethodFunc builtin_method);
 
 	Callable to_callable() const;
 	sol::object call(sol::this_state state, const sol::stack_object& self, const sol::variadic_args& args) const override;
@@ -86,18 +88,23 @@ public:
 
 protected:
 	Variant variant;
+	// Engine MethodBind for Object methods, called without looking up the method by name
+	GDExtensionMethodBindPtr method_bind = nullptr;
+	// Typed binding for builtin methods, called with arguments read directly from the Lua stack
+	BuiltinMethodFunc builtin_method = nullptr;
 };
 
 
 class VariantTypeMethodBind : public BaseMethodBind {
 public:
-	VariantTypeMethodBind(const VariantType& type, const StringName& method_name);
+	VariantTypeMethodBind(const VariantType& type, const StringName& method_name, BuiltinMethodFunc builtin_method = nullptr);
 
 	sol::object call(sol::this_state state, const sol::stack_object& self, const sol::variadic_args& args) const override;
 	static void register_usertype(sol::state_view& state);
 
 protected:
 	VariantType type;
+	BuiltinMethodFunc builtin_method;
 };
 
 }
@@ -0,0 +1,283 @@
+/**
+ * Copyright (C) 2026 Gil Barbosa Reis.
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the “Software”), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ * of the Software, and to permit persons to whom the Software is furnished to do
+ * so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#include "object_method_binds.hpp"
+
+#include "VariantArguments.hpp"
+#include "convert_godot_lua.hpp"
+#include "performance_monitors.hpp"
+#include "string_names.hpp"
+#include "../LuaTracer.hpp"
+#include "../generated/method_bind_hashes.h"
+
+#include <godot_cpp/classes/class_db_singleton.hpp>
+#include <godot_cpp/classes/script.hpp>
+#include <godot_cpp/godot.hpp>
+#include <godot_cpp/variant/dictionary.hpp>
+#include <godot_cpp/variant/typed_array.hpp>
+#include <godot_cpp/templates/hash_map.hpp>
+#include <godot_cpp/templates/hash_set.hpp>
+
+#include <shared_mutex>
+
+namespace luagdextension {
+
+// Method binds may be resolved from Lua states running in different threads.
+// Lookups of cached entries only take a shared lock.
+static std::shared_mutex method_binds_mutex;
+// { engine_class: { method: hash } }
+static HashMap<StringName, HashMap<StringName, int64_t>> engine_method_hashes;
+// Names of methods in any engine class, so that other names are not cached
+static HashSet<StringName> engine_method_names;
+// { engine_class: { property: accessor names } }
+static HashMap<StringName, HashMap<StringName, const PropertyAccessorNames *>> engine_properties;
+// Names of properties in any engine class, so that other names are not cached
+static HashSet<StringName> engine_property_names;
+// { object_class: { name: method and property binds, empty for non-engine members } }
+static HashMap<StringName, HashMap<StringName, ObjectMember>> members_by_class;
+
+enum ScriptMemberFlags : uint8_t {
+	SCRIPT_OVERRIDES_METHOD = 1 << 0,
+	SCRIPT_HANDLES_PROPERTY = 1 << 1,
+};
+// Resolved separately, since checking scripts may call back into Lua
+static std::shared_mutex script_members_mutex;
+// { script instance ID: { engine member name: ScriptMemberFlags } }
+static HashMap<uint64_t, HashMap<StringName, uint8_t>> script_member_flags;
+
+static void fill_engine_tables() {
+	if (!engine_method_hashes.is_empty()) {
+		return;
+	}
+	for (const MethodBindHash& method_bind_hash : method_bind_hashes) {
+		engine_method_hashes[method_bind_hash.class_name].insert(method_bind_hash.method_name, method_bind_hash.hash);
+		engine_method_names.insert(method_bind_hash.method_name);
+	}
+	for (const PropertyAccessorNames& names : property_accessor_names) {
+		engine_properties[names.class_name].insert(names.property_name, &names);
+		engine_property_names.insert(names.property_name);
+	}
+}
+
+static GDExtensionMethodBindPtr resolve_method_bind(const StringName& class_name, const StringName& method) {
+	fill_engine_tables();
+
+	ClassDBSingleton *class_db = ClassDBSingleton::get_singleton();
+	for (StringName cls = class_name; !cls.is_empty(); cls = class_db->get_parent_class(cls)) {
+		if (const HashMap<StringName, int64_t> *methods = engine_method_hashes.getptr(cls)) {
+			if (const int64_t *hash = methods->getptr(method)) {
+				return gdextension_interface::classdb_get_method_bind(cls._native_ptr(), method._native_ptr(), *hash);
+			}
+		}
+		else if (class_db->class_has_method(cls, method, true)) {
+			// Method defined by an extension class
+			return nullptr;
+		}
+	}
+	return nullptr;
+}
+
+static bool class_has_own_property(ClassDBSingleton *class_db, const StringName& cls, const StringName& property) {
+	TypedArray<Dictionary> properties = class_db->class_get_property_list(cls, true);
+	for (int i = 0; i < properties.size(); i++) {
+		if (StringName(Dictionary(properties[i]).get("name", "")) == property) {
+			return true;
+		}
+	}
+	return false;
+}
+
+static ObjectPropertyAccessor resolve_property_accessor(const StringName& class_name, const StringName& property) {
+	fill_engine_tables();
+
+	ObjectPropertyAccessor accessor;
+	ClassDBSingleton *class_db = ClassDBSingleton::get_singleton();
+	for (StringName cls = class_name; !cls.is_empty(); cls = class_db->get_parent_class(cls)) {
+		if (const HashMap<StringName, const PropertyAccessorNames *> *properties = engine_properties.getptr(cls)) {
+			if (const PropertyAccessorNames *const *names = properties->getptr(property)) {
+				if ((*names)->getter[0]) {
+					accessor.getter = resolve_method_bind(cls, (*names)->getter);
+				}
+				if ((*names)->setter[0]) {
+					accessor.setter = resolve_method_bind(cls, (*names)->setter);
+				}
+				accessor.index = (*names)->index;
+				break;
+			}
+		}
+		else if (!engine_method_hashes.has(cls) && class_has_own_property(class_db, cls, property)) {
+			// Property defined by an extension class
+			break;
+		}
+	}
+	return accessor;
+}
+
+static bool find_cached_member(const StringName& class_name, const StringName& name, ObjectMember& member) {
+	if (!engine_method_hashes.is_empty() && !engine_method_names.has(name) && !engine_property_names.has(name)) {
+		// Not an engine method or property in any class, like script members
+		member = ObjectMember();
+		return true;
+	}
+	if (const HashMap<StringName, ObjectMember> *members = members_by_class.getptr(class_name)) {
+		if (const ObjectMember *cached = members->getptr(name)) {
+			member = *cached;
+			return true;
+		}
+	}
+	return false;
+}
+
+static bool script_declares_property(Script *script, const StringName& name) {
+	TypedArray<Dictionary> properties = script->get_script_property_list();
+	for (int i = 0; i < properties.size(); i++) {
+		if (StringName(Dictionary(properties[i]).get("name", "")) == name) {
+			return true;
+		}
+	}
+	return false;
+}
+
+static uint8_t get_script_member_flags(Script *script, const StringName& name) {
+	uint64_t script_id = script->get_instance_id();
+	{
+		std::shared_lock lock(script_members_mutex);
+		if (const HashMap<StringName, uint8_t> *members = script_member_flags.getptr(script_id)) {
+			if (const uint8_t *flags = members->getptr(name)) {
+				return *flags;
+			}
+		}
+	}
+
+	uint8_t flags = 0;
+	if (script->has_method(name)) {
+		flags |= SCRIPT_OVERRIDES_METHOD;
+	}
+	// Scripts may handle any property in `_get` and `_set` before the engine does
+	if (script->has_method(string_names->_get) || script->has_method(string_names->_set) || script_declares_property(script, name)) {
+		flags |= SCRIPT_HANDLES_PROPERTY;
+	}
+	std::unique_lock lock(script_members_mutex);
+	script_member_flags[script_id].insert(name, flags);
+	return flags;
+}
+
+ObjectMember get_object_member(const Object *object, const StringName& name) {
+	StringName class_name;
+	gdextension_interface::object_get_class_name(object->_owner, internal::library, class_name._native_ptr());
+
+	ObjectMember member;
+	bool found;
+	{
+		std::shared_lock lock(method_binds_mutex);
+		found = find_cached_member(class_name, name, member);
+	}
+	if (!found) {
+		std::unique_lock lock(method_binds_mutex);
+		fill_engine_tables();
+		if (!find_cached_member(class_name, name, member)) {
+			member.method_bind = resolve_method_bind(class_name, name);
+			// Methods are looked up first when indexing, so properties are only resolved for names that are not methods
+			if (member.method_bind == nullptr) {
+				member.property = resolve_property_accessor(class_name, name);
+			}
+			members_by_class[class_name].insert(name, member);
+		}
+	}
+
+	if (member.method_bind || member.property.getter) {
+		// Script methods override engine methods when called by name,
+		// and script properties, `_get` and `_set` are handled before engine properties
+		if (Script *script = Object::cast_to<Script>(object->get_script())) {
+			uint8_t flags = get_script_member_flags(script, name);
+			if (flags & SCRIPT_OVERRIDES_METHOD) {
+				member.method_bind = nullptr;
+			}
+			if (flags & SCRIPT_HANDLES_PROPERTY) {
+				member.property = ObjectPropertyAccessor();
+			}
+		}
+	}
+	return member;
+}
+
+void clear_object_method_binds() {
+	std::unique_lock lock(method_binds_mutex);
+	engine_method_hashes.reset();
+	engine_method_names.reset();
+	engine_properties.reset();
+	engine_property_names.reset();
+	members_by_class.reset();
+
+	std::unique_lock script_lock(script_members_mutex);
+	script_member_flags.reset();
+}
+
+bool object_property_get(Object *object, const StringName& property, const ObjectPropertyAccessor& accessor, Variant& result) {
+	Variant index = accessor.index;
+	const Variant *args[] = { &index };
+	Variant value;
+	GDExtensionCallError error;
+	godot_calls_from_lua.fetch_add(1, std::memory_order_relaxed);
+	LuaTracer::Scope trace_scope(LuaTracer::LUA_TO_GODOT, "object_property_get", &property);
+	gdextension_interface::object_method_bind_call(accessor.getter, object->_owner, (GDExtensionConstVariantPtr *) args, accessor.index >= 0 ? 1 : 0, value._native_ptr(), &error);
+	if (error.error != GDEXTENSION_CALL_OK) {
+		return false;
+	}
+	result = value;
+	return true;
+}
+
+bool object_property_set(Object *object, const StringName& property, const ObjectPropertyAccessor& accessor, const Variant& value) {
+	if (accessor.setter == nullptr) {
+		return false;
+	}
+	Variant index = accessor.index;
+	const Variant *args[] = { &index, &value };
+	int argc = 2;
+	if (accessor.index < 0) {
+		args[0] = &value;
+		argc = 1;
+	}
+	Variant ret;
+	GDExtensionCallError error;
+	godot_calls_from_lua.fetch_add(1, std::memory_order_relaxed);
+	LuaTracer::Scope trace_scope(LuaTracer::LUA_TO_GODOT, "object_property_set", &property);
+	gdextension_interface::object_method_bind_call(accessor.setter, object->_owner, (GDExtensionConstVariantPtr *) args, argc, ret._native_ptr(), &error);
+	return error.error == GDEXTENSION_CALL_OK;
+}
+
+sol::object object_method_bind_call(sol::this_state state, Object *object, GDExtensionMethodBindPtr method_bind, const StringName& method, const sol::variadic_args& args) {
+	VariantArguments variant_args = args;
+
+	Variant result;
+	GDExtensionCallError error;
+	godot_calls_from_lua.fetch_add(1, std::memory_order_relaxed);
+	LuaTracer::Scope trace_scope(LuaTracer::LUA_TO_GODOT, "object_method_bind_call", &method);
+	gdextension_interface::object_method_bind_call(method_bind, object->_owner, (GDExtensionConstVariantPtr *) variant_args.argv(), variant_args.argc(), result._native_ptr(), &error);
+	if (error.error != GDEXTENSION_CALL_OK) {
+		String message = String("Invalid call to method '{0}' in object of type {1}").format(Array::make(method, object->get_class()));
+		lua_error(state, error, message);
+	}
+	return to_lua(state, result);
+}
+
+}
@@ -0,0 +1,76 @@
+/**
+ * Copyright (C) 2026 Gil Barbosa Reis.
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the “Software”), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ * of the Software, and to permit persons to whom the Software is furnished to do
+ * so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#ifndef __UTILS_OBJECT_METHOD_BINDS_HPP__
+#define __UTILS_OBJECT_METHOD_BINDS_HPP__
+
+#include "custom_sol.hpp"
+
+#include <godot_cpp/core/object.hpp>
+
+using namespace godot;
+
+namespace luagdextension {
+
+/**
+ * Getter and setter MethodBinds of an engine property, with the index passed to them for indexed properties.
+ * Setter is nullptr for read-only properties.
+ */
+struct ObjectPropertyAccessor {
+	GDExtensionMethodBindPtr getter = nullptr;
+	GDExtensionMethodBindPtr setter = nullptr;
+	int64_t index = -1;
+};
+
+/**
+ * Engine method or property named like an Object member.
+ * `method_bind` is nullptr if the member is not an engine method, like extension or script methods.
+ * `property.getter` is nullptr if the member is not an engine property, or if it is also a method.
+ */
+struct ObjectMember {
+	GDExtensionMethodBindPtr method_bind = nullptr;
+	ObjectPropertyAccessor property;
+};
+
+/**
+ * Finds the engine method or property named `name` in `object`.
+ * Members are resolved once per (class, name) and cached in a single entry, only for names of engine methods and properties.
+ * Members handled by the object's script are returned empty, so that they are accessed by name:
+ * methods defined by the script, and properties if the script declares them or defines `_get` or `_set`.
+ * This is cached per script and name.
+ */
+ObjectMember get_object_member(const Object *object, const StringName& name);
+
+// Gets and sets engine properties calling their accessors directly, returning false if the call failed
+bool object_property_get(Object *object, const StringName& property, const ObjectPropertyAccessor& accessor, Variant& result);
+bool object_property_set(Object *object, const StringName& property, const ObjectPropertyAccessor& accessor, const Variant& value);
+
+/**
+ * Calls an engine method using its MethodBind, skipping method lookup by name.
+ */
+sol::object object_method_bind_call(sol::this_state state, Object *object, GDExtensionMethodBindPtr method_bind, const StringName& method, const sol::variadic_args& args);
+
+// Frees cached MethodBinds, must be called before the extension is unloaded
+void clear_object_method_binds();
+
+}
+
+#endif  // __UTILS_OBJECT_METHOD_BINDS_HPP__
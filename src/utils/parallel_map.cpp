@@ -0,0 +1,352 @@
+/**
+ * Copyright (C) 2026 Gil Barbosa Reis.
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the “Software”), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ * of the Software, and to permit persons to whom the Software is furnished to do
+ * so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#include "parallel_map.hpp"
+
+#include "convert_godot_lua.hpp"
+#include "../LuaError.hpp"
+#include "../LuaState.hpp"
+
+#include <atomic>
+#include <cmath>
+#include <limits>
+#include <mutex>
+
+#include <gdextension_interface.h>
+#include <godot_cpp/classes/worker_thread_pool.hpp>
+#include <godot_cpp/templates/local_vector.hpp>
+
+namespace luagdextension {
+
+// Lua state cached by each worker thread, reused while the opened libraries are the same
+struct ParallelMapWorker {
+	Ref<LuaState> lua_state;
+	int64_t libraries = -1;
+	uint64_t job_id = 0;
+	int function_ref = LUA_NOREF;
+};
+
+struct ParallelMapJob {
+	uint64_t id;
+	PackedByteArray bytecode;
+	int64_t libraries;
+	int64_t size;
+	int64_t chunk_size;
+	const void *input;
+	void *output;
+	bool (*map_chunk)(ParallelMapJob *job, lua_State *L, int function_ref, int64_t from, int64_t to);
+
+	std::atomic<bool> failed = false;
+	std::mutex error_mutex;
+	LuaError::Status error_status = LuaError::OK;
+	String error_message;
+
+	void fail(LuaError::Status status, const String& message) {
+		std::lock_guard lock(error_mutex);
+		if (!failed.load()) {
+			error_status = status;
+			error_message = message;
+			failed.store(true);
+		}
+	}
+};
+
+static std::atomic<uint64_t> parallel_map_job_count = 0;
+static thread_local ParallelMapWorker *parallel_map_worker = nullptr;
+static std::mutex parallel_map_workers_mutex;
+static LocalVector<ParallelMapWorker *> parallel_map_workers;
+
+static int bytecode_writer(lua_State *L, const void *data, size_t size, void *userdata) {
+	PackedByteArray *bytecode = (PackedByteArray *) userdata;
+	int64_t offset = bytecode->size();
+	bytecode->resize(offset + size);
+	memcpy(bytecode->ptrw() + offset, data, size);
+	return 0;
+}
+
+static void push_element(lua_State *L, uint8_t value) {
+	lua_pushinteger(L, value);
+}
+
+static void push_element(lua_State *L, int32_t value) {
+	lua_pushinteger(L, value);
+}
+
+static void push_element(lua_State *L, int64_t value) {
+	lua_pushinteger(L, value);
+}
+
+static void push_element(lua_State *L, float value) {
+	lua_pushnumber(L, value);
+}
+
+static void push_element(lua_State *L, double value) {
+	lua_pushnumber(L, value);
+}
+
+template<typename T>
+static void push_element(lua_State *L, const T& value) {
+	lua_push(L, Variant(value));
+}
+
+template<typename T>
+static bool get_integer_element(lua_State *L, int index, T& value) {
+	int isnum;
+	lua_Integer integer = lua_tointegerx(L, index, &isnum);
+	// Values that don't fit the array's element type are rejected instead of wrapping around
+	if (!isnum || integer < std::numeric_limits<T>::min() || integer > std::numeric_limits<T>::max()) {
+		return false;
+	}
+	value = (T) integer;
+	return true;
+}
+
+static bool get_element(lua_State *L, int index, uint8_t& value) {
+	return get_integer_element(L, index, value);
+}
+
+static bool get_element(lua_State *L, int index, int32_t& value) {
+	return get_integer_element(L, index, value);
+}
+
+static bool get_element(lua_State *L, int index, int64_t& value) {
+	return get_integer_element(L, index, value);
+}
+
+static bool get_element(lua_State *L, int index, float& value) {
+	int isnum;
+	lua_Number number = lua_tonumberx(L, index, &isnum);
+	// Finite values that overflow float would silently become infinity
+	if (!isnum || (std::isfinite(number) && std::abs(number) > std::numeric_limits<float>::max())) {
+		return false;
+	}
+	value = (float) number;
+	return true;
+}
+
+static bool get_element(lua_State *L, int index, double& value) {
+	int isnum;
+	value = lua_tonumberx(L, index, &isnum);
+	return isnum;
+}
+
+template<typename T>
+static bool get_element(lua_State *L, int index, T& value) {
+	Variant variant = to_variant(L, index);
+	if (variant.get_type() != GetTypeInfo<T>::VARIANT_TYPE) {
+		return false;
+	}
+	value = variant;
+	return true;
+}
+
+template<typename T>
+static bool map_chunk(ParallelMapJob *job, lua_State *L, int function_ref, int64_t from, int64_t to) {
+	const T *input = (const T *) job->input;
+	T *output = (T *) job->output;
+	for (int64_t i = from; i < to; i++) {
+		lua_rawgeti(L, LUA_REGISTRYINDEX, function_ref);
+		push_element(L, input[i]);
+		lua_pushinteger(L, i);
+		int status = lua_pcall(L, 2, 1, 0);
+		if (status != LUA_OK) {
+			job->fail((LuaError::Status) status, lua_tostring(L, -1));
+			lua_pop(L, 1);
+			return false;
+		}
+		if (!get_element(L, -1, output[i])) {
+			job->fail(LuaError::RUNTIME, String("parallel_map function returned an invalid or out of range value at index %d, expected %s") % Array::make(i, Variant::get_type_name(GetTypeInfo<T>::VARIANT_TYPE)));
+			lua_pop(L, 1);
+			return false;
+		}
+		lua_pop(L, 1);
+	}
+	return true;
+}
+
+static ParallelMapWorker *acquire_worker(ParallelMapJob *job) {
+	ParallelMapWorker *worker = parallel_map_worker;
+	if (worker == nullptr) {
+		worker = memnew(ParallelMapWorker);
+		std::lock_guard lock(parallel_map_workers_mutex);
+		parallel_map_workers.push_back(worker);
+		parallel_map_worker = worker;
+	}
+
+	if (worker->libraries != job->libraries) {
+		worker->lua_state.instantiate();
+		worker->lua_state->open_libraries(job->libraries);
+		worker->libraries = job->libraries;
+		worker->job_id = 0;
+		worker->function_ref = LUA_NOREF;
+	}
+
+	if (worker->job_id != job->id) {
+		lua_State *L = worker->lua_state->get_lua_state().lua_state();
+		luaL_unref(L, LUA_REGISTRYINDEX, worker->function_ref);
+		worker->function_ref = LUA_NOREF;
+		worker->job_id = 0;
+
+		int status = luaL_loadbufferx(L, (const char *) job->bytecode.ptr(), job->bytecode.size(), "=parallel_map", "b");
+		if (status == LUA_OK) {
+			// Each job runs in a fresh environment, so globals set by previous jobs are not visible
+			lua_newtable(L);
+			lua_newtable(L);
+			lua_pushglobaltable(L);
+			lua_setfield(L, -2, "__index");
+			lua_setmetatable(L, -2);
+			lua_pushvalue(L, -1);
+			lua_setfield(L, -2, "_G");
+#if LUA_VERSION_NUM >= 502
+			lua_setupvalue(L, -2, 1);
+#else
+			lua_setfenv(L, -2);
+#endif
+			status = lua_pcall(L, 0, 1, 0);
+		}
+		if (status != LUA_OK) {
+			job->fail((LuaError::Status) status, lua_tostring(L, -1));
+			lua_pop(L, 1);
+			return nullptr;
+		}
+		if (!lua_isfunction(L, -1)) {
+			job->fail(LuaError::RUNTIME, "parallel_map source must return a function");
+			lua_pop(L, 1);
+			return nullptr;
+		}
+		worker->function_ref = luaL_ref(L, LUA_REGISTRYINDEX);
+		worker->job_id = job->id;
+	}
+	return worker;
+}
+
+static void parallel_map_task(void *userdata, uint32_t chunk_index) {
+	ParallelMapJob *job = (ParallelMapJob *) userdata;
+	if (job->failed.load(std::memory_order_relaxed)) {
+		return;
+	}
+	ParallelMapWorker *worker = acquire_worker(job);
+	if (worker == nullptr) {
+		return;
+	}
+	int64_t from = chunk_index * job->chunk_size;
+	int64_t to = MIN(from + job->chunk_size, job->size);
+	job->map_chunk(job, worker->lua_state->get_lua_state().lua_state(), worker->function_ref, from, to);
+}
+
+template<typename TArray>
+static Variant parallel_map_array(ParallelMapJob& job, const TArray& input) {
+	using T = std::remove_cvref_t<decltype(*input.ptr())>;
+
+	TArray output;
+	output.resize(input.size());
+	if (input.is_empty()) {
+		return output;
+	}
+	job.size = input.size();
+	job.input = input.ptr();
+	// Make the output unique in this thread, so that workers write to a stable buffer
+	job.output = output.ptrw();
+	job.map_chunk = &map_chunk<T>;
+
+	// Group tasks are indexed with 32-bit integers, so huge arrays use bigger chunks
+	int64_t max_chunk_count = std::numeric_limits<int32_t>::max();
+	if (job.size / job.chunk_size >= max_chunk_count) {
+		job.chunk_size = job.size / max_chunk_count + 1;
+	}
+	int chunk_count = job.size / job.chunk_size + (job.size % job.chunk_size != 0);
+	WorkerThreadPool *pool = WorkerThreadPool::get_singleton();
+	String description = "LuaState.parallel_map";
+	int64_t group_id = gdextension_interface::worker_thread_pool_add_native_group_task(pool->_owner, &parallel_map_task, &job, chunk_count, -1, false, description._native_ptr());
+	pool->wait_for_group_task_completion(group_id);
+
+	if (job.failed.load()) {
+		return memnew(LuaError(job.error_status, job.error_message));
+	}
+	return output;
+}
+
+Variant parallel_map(LuaState *lua_state, const String& function_source, const Variant& packed_array, int64_t chunk_size) {
+	ERR_FAIL_COND_V_MSG(chunk_size <= 0, Variant(), "Chunk size must be positive");
+
+	// Compile the source once, worker states load the resulting bytecode
+	sol::state_view state = lua_state->get_lua_state();
+	lua_State *L = state.lua_state();
+	CharString source = function_source.utf8();
+	int status = luaL_loadbufferx(L, source.get_data(), source.length(), "=parallel_map", "t");
+	if (status != LUA_OK) {
+		String message = lua_tostring(L, -1);
+		lua_pop(L, 1);
+		return memnew(LuaError((LuaError::Status) status, message));
+	}
+	ParallelMapJob job;
+	job.id = parallel_map_job_count.fetch_add(1, std::memory_order_relaxed) + 1;
+#if LUA_VERSION_NUM >= 503
+	lua_dump(L, &bytecode_writer, &job.bytecode, 0);
+#else
+	lua_dump(L, &bytecode_writer, &job.bytecode);
+#endif
+	lua_pop(L, 1);
+	job.libraries = state.registry().get_or("_GDEXTENSION_OPEN_LIBS", 0L);
+	job.chunk_size = chunk_size;
+
+	switch (packed_array.get_type()) {
+		case Variant::PACKED_BYTE_ARRAY:
+			return parallel_map_array(job, (PackedByteArray) packed_array);
+
+		case Variant::PACKED_INT32_ARRAY:
+			return parallel_map_array(job, (PackedInt32Array) packed_array);
+
+		case Variant::PACKED_INT64_ARRAY:
+			return parallel_map_array(job, (PackedInt64Array) packed_array);
+
+		case Variant::PACKED_FLOAT32_ARRAY:
+			return parallel_map_array(job, (PackedFloat32Array) packed_array);
+
+		case Variant::PACKED_FLOAT64_ARRAY:
+			return parallel_map_array(job, (PackedFloat64Array) packed_array);
+
+		case Variant::PACKED_VECTOR2_ARRAY:
+			return parallel_map_array(job, (PackedVector2Array) packed_array);
+
+		case Variant::PACKED_VECTOR3_ARRAY:
+			return parallel_map_array(job, (PackedVector3Array) packed_array);
+
+		case Variant::PACKED_VECTOR4_ARRAY:
+			return parallel_map_array(job, (PackedVector4Array) packed_array);
+
+		case Variant::PACKED_COLOR_ARRAY:
+			return parallel_map_array(job, (PackedColorArray) packed_array);
+
+		default:
+			ERR_FAIL_V_MSG(Variant(), String("parallel_map does not support %s values") % Variant::get_type_name(packed_array.get_type()));
+	}
+}
+
+void free_parallel_map_workers() {
+	std::lock_guard lock(parallel_map_workers_mutex);
+	for (ParallelMapWorker *worker : parallel_map_workers) {
+		memdelete(worker);
+	}
+	parallel_map_workers.clear();
+}
+
+}
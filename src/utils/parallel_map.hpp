@@ -0,0 +1,42 @@
+/**
+ * Copyright (C) 2026 Gil Barbosa Reis.
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the “Software”), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ * of the Software, and to permit persons to whom the Software is furnished to do
+ * so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#ifndef __UTILS_PARALLEL_MAP_HPP__
+#define __UTILS_PARALLEL_MAP_HPP__
+
+#include <godot_cpp/variant/variant.hpp>
+
+using namespace godot;
+
+namespace luagdextension {
+
+class LuaState;
+
+// Maps each element of a Packed array with the function returned by `function_source`,
+// running chunks of the array in WorkerThreadPool threads
+Variant parallel_map(LuaState *lua_state, const String& function_source, const Variant& packed_array, int64_t chunk_size);
+
+// Frees the cached Lua states used by worker threads
+void free_parallel_map_workers();
+
+}
+
+#endif  // __UTILS_PARALLEL_MAP_HPP__
@@ -0,0 +1,192 @@
+/**
+ * Copyright (C) 2026 Gil Barbosa Reis.
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the “Software”), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ * of the Software, and to permit persons to whom the Software is furnished to do
+ * so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#include "performance_monitors.hpp"
+
+#include "../LuaCoroutine.hpp"
+#include "../LuaObject.hpp"
+#include "../script-language/LuaScriptLanguage.hpp"
+
+#include <godot_cpp/classes/performance.hpp>
+#include <godot_cpp/core/object.hpp>
+#include <godot_cpp/variant/callable_method_pointer.hpp>
+
+using namespace godot;
+
+namespace luagdextension {
+
+std::atomic<uint64_t> lua_calls_from_godot = 0;
+std::atomic<uint64_t> godot_calls_from_lua = 0;
+static uint64_t last_frame_lua_calls_from_godot = 0;
+static uint64_t last_frame_godot_calls_from_lua = 0;
+
+static LuaState *get_script_lua_state() {
+	LuaScriptLanguage *language = LuaScriptLanguage::get_singleton();
+	return language ? language->get_lua_state() : nullptr;
+}
+
+static LuaState *get_lua_state(uint64_t lua_state_id) {
+	return Object::cast_to<LuaState>(ObjectDB::get_instance(lua_state_id));
+}
+
+// Monitors run in the main thread while LuaStates may be running in other threads,
+// so they only read values published by the thread running the state
+static uint64_t get_memory_used(LuaState *lua_state) {
+	return lua_state ? lua_state->get_monitor_values().memory_used.load(std::memory_order_relaxed) : 0;
+}
+
+// GC stats are only updated by `LuaState::step_gc_with_budget`, including the per frame GC scheduler
+static int64_t get_gc_time_usec(LuaState *lua_state) {
+	return lua_state ? lua_state->get_monitor_values().gc_last_step_usec.load(std::memory_order_relaxed) : 0;
+}
+
+static int get_gc_steps(LuaState *lua_state) {
+	return lua_state ? lua_state->get_monitor_values().gc_last_step_count.load(std::memory_order_relaxed) : 0;
+}
+
+static int get_coroutine_pool_size(LuaState *lua_state) {
+	return lua_state ? lua_state->get_monitor_values().coroutine_pool_size.load(std::memory_order_relaxed) : 0;
+}
+
+static uint64_t get_script_memory_used() {
+	return get_memory_used(get_script_lua_state());
+}
+
+static int64_t get_script_gc_time_usec() {
+	return get_gc_time_usec(get_script_lua_state());
+}
+
+static int get_script_gc_steps() {
+	return get_gc_steps(get_script_lua_state());
+}
+
+static int get_script_coroutine_pool_size() {
+	return get_coroutine_pool_size(get_script_lua_state());
+}
+
+static uint64_t get_state_memory_used(uint64_t lua_state_id) {
+	return get_memory_used(get_lua_state(lua_state_id));
+}
+
+static int64_t get_state_gc_time_usec(uint64_t lua_state_id) {
+	return get_gc_time_usec(get_lua_state(lua_state_id));
+}
+
+static int get_state_gc_steps(uint64_t lua_state_id) {
+	return get_gc_steps(get_lua_state(lua_state_id));
+}
+
+static int get_state_coroutine_pool_size(uint64_t lua_state_id) {
+	return get_coroutine_pool_size(get_lua_state(lua_state_id));
+}
+
+static uint64_t get_lua_calls_from_godot() {
+	return last_frame_lua_calls_from_godot;
+}
+
+static uint64_t get_godot_calls_from_lua() {
+	return last_frame_godot_calls_from_lua;
+}
+
+static int get_object_wrapper_count() {
+	return LuaObject::get_known_object_count();
+}
+
+static int get_coroutine_object_count() {
+	return LuaCoroutine::get_alive_count();
+}
+
+static const char *MEMORY_MONITOR = "Lua/Memory (bytes)";
+static const char *GC_TIME_MONITOR = "Lua/GC Time (usec)";
+static const char *GC_STEPS_MONITOR = "Lua/GC Steps";
+static const char *CALLS_FROM_GODOT_MONITOR = "Lua/Calls From Godot";
+static const char *CALLS_TO_GODOT_MONITOR = "Lua/Calls To Godot";
+static const char *OBJECT_WRAPPERS_MONITOR = "Lua/Object Wrappers";
+static const char *COROUTINE_OBJECTS_MONITOR = "Lua/Coroutine Objects";
+static const char *COROUTINE_POOL_MONITOR = "Lua/Coroutine Pool Size";
+
+static void add_monitor(Performance *performance, const StringName& id, const Callable& callable, const Array& arguments = Array()) {
+	if (!performance->has_custom_monitor(id)) {
+		performance->add_custom_monitor(id, callable, arguments);
+	}
+}
+
+static String get_lua_state_monitor_id(const String& name, const char *monitor) {
+	// Monitor IDs are "category/name", so each LuaState gets its own category in the debugger
+	return vformat("Lua (%s)/%s", name, String(monitor).get_slice("/", 1));
+}
+
+static void remove_monitor(Performance *performance, const StringName& id) {
+	if (performance->has_custom_monitor(id)) {
+		performance->remove_custom_monitor(id);
+	}
+}
+
+void register_performance_monitors() {
+	Performance *performance = Performance::get_singleton();
+	add_monitor(performance, MEMORY_MONITOR, callable_mp_static(&get_script_memory_used));
+	add_monitor(performance, GC_TIME_MONITOR, callable_mp_static(&get_script_gc_time_usec));
+	add_monitor(performance, GC_STEPS_MONITOR, callable_mp_static(&get_script_gc_steps));
+	add_monitor(performance, CALLS_FROM_GODOT_MONITOR, callable_mp_static(&get_lua_calls_from_godot));
+	add_monitor(performance, CALLS_TO_GODOT_MONITOR, callable_mp_static(&get_godot_calls_from_lua));
+	add_monitor(performance, OBJECT_WRAPPERS_MONITOR, callable_mp_static(&get_object_wrapper_count));
+	add_monitor(performance, COROUTINE_OBJECTS_MONITOR, callable_mp_static(&get_coroutine_object_count));
+	add_monitor(performance, COROUTINE_POOL_MONITOR, callable_mp_static(&get_script_coroutine_pool_size));
+}
+
+void unregister_performance_monitors() {
+	Performance *performance = Performance::get_singleton();
+	remove_monitor(performance, MEMORY_MONITOR);
+	remove_monitor(performance, GC_TIME_MONITOR);
+	remove_monitor(performance, GC_STEPS_MONITOR);
+	remove_monitor(performance, CALLS_FROM_GODOT_MONITOR);
+	remove_monitor(performance, CALLS_TO_GODOT_MONITOR);
+	remove_monitor(performance, OBJECT_WRAPPERS_MONITOR);
+	remove_monitor(performance, COROUTINE_OBJECTS_MONITOR);
+	remove_monitor(performance, COROUTINE_POOL_MONITOR);
+}
+
+void register_lua_state_performance_monitors(const String& name, uint64_t lua_state_id) {
+	Performance *performance = Performance::get_singleton();
+	Array arguments = Array::make(lua_state_id);
+	add_monitor(performance, get_lua_state_monitor_id(name, MEMORY_MONITOR), callable_mp_static(&get_state_memory_used), arguments);
+	add_monitor(performance, get_lua_state_monitor_id(name, GC_TIME_MONITOR), callable_mp_static(&get_state_gc_time_usec), arguments);
+	add_monitor(performance, get_lua_state_monitor_id(name, GC_STEPS_MONITOR), callable_mp_static(&get_state_gc_steps), arguments);
+	add_monitor(performance, get_lua_state_monitor_id(name, COROUTINE_POOL_MONITOR), callable_mp_static(&get_state_coroutine_pool_size), arguments);
+}
+
+void unregister_lua_state_performance_monitors(const String& name) {
+	Performance *performance = Performance::get_singleton();
+	if (performance == nullptr) {
+		return;
+	}
+	remove_monitor(performance, get_lua_state_monitor_id(name, MEMORY_MONITOR));
+	remove_monitor(performance, get_lua_state_monitor_id(name, GC_TIME_MONITOR));
+	remove_monitor(performance, get_lua_state_monitor_id(name, GC_STEPS_MONITOR));
+	remove_monitor(performance, get_lua_state_monitor_id(name, COROUTINE_POOL_MONITOR));
+}
+
+void performance_monitors_frame() {
+	last_frame_lua_calls_from_godot = lua_calls_from_godot.exchange(0, std::memory_order_relaxed);
+	last_frame_godot_calls_from_lua = godot_calls_from_lua.exchange(0, std::memory_order_relaxed);
+}
+
+}
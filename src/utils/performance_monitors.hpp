@@ -0,0 +1,50 @@
+/**
+ * Copyright (C) 2026 Gil Barbosa Reis.
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the “Software”), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ * of the Software, and to permit persons to whom the Software is furnished to do
+ * so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#ifndef __UTILS_PERFORMANCE_MONITORS_HPP__
+#define __UTILS_PERFORMANCE_MONITORS_HPP__
+
+#include <atomic>
+#include <cstdint>
+
+#include <godot_cpp/variant/string.hpp>
+
+using namespace godot;
+
+namespace luagdextension {
+
+// Calls crossing the Godot/Lua boundary in the current frame, from any thread
+extern std::atomic<uint64_t> lua_calls_from_godot;
+extern std::atomic<uint64_t> godot_calls_from_lua;
+
+// Registers "Lua/*" custom monitors in Godot's Performance singleton
+void register_performance_monitors();
+void unregister_performance_monitors();
+// Registers "Lua (name)/*" memory, GC and coroutine pool monitors for a user LuaState.
+// Monitors find the LuaState by its instance ID, so they don't keep it alive.
+void register_lua_state_performance_monitors(const String& name, uint64_t lua_state_id);
+void unregister_lua_state_performance_monitors(const String& name);
+// Saves per frame counters for the monitors and resets them
+void performance_monitors_frame();
+
+}
+
+#endif  // __UTILS_PERFORMANCE_MONITORS_HPP__
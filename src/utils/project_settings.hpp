@@ -28,6 +28,7 @@ constexpr char LUA_PATH_SETTING[] = "lua_gdextension/lua_script_language/package
 constexpr char LUA_CPATH_SETTING[] = "lua_gdextension/lua_script_language/package_c_path";
 constexpr char LUA_CPATH_WINDOWS_SETTING[] = "lua_gdextension/lua_script_language/package_c_path.windows";
 constexpr char LUA_CPATH_MACOS_SETTING[] = "lua_gdextension/lua_script_language/package_c_path.macos";
+constexpr char LUA_GC_FRAME_BUDGET_SETTING[] = "lua_gdextension/lua_script_language/gc_frame_budget_usec";
 constexpr char LUA_SCRIPT_IMPORT_MAP_SETTING[] = "lua_gdextension/lua_script_language/script_import_map";
 constexpr char LUA_SCRIPT_IMPORT_MAP_SETTING_EDITOR[] = "lua_gdextension/lua_script_language/script_import_map.editor";
 
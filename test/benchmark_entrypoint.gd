@@ -0,0 +1,73 @@
+extends SceneTree
+## Headless interop benchmarks.
+## Usage: godot --headless --path test --script benchmark_entrypoint.gd -- [--iterations=N] [--filter=TEXT] [--output=PATH]
+## Results are printed as JSON and optionally written to PATH, tagged with the Lua runtime in use.
+
+const BENCHMARK_DIR = "res://benchmarks"
+const DEFAULT_ITERATIONS = 10000
+const SAMPLES = 5
+
+var iterations = DEFAULT_ITERATIONS
+var filter = ""
+var output_path = ""
+
+
+func _process(_delta):
+	for arg in OS.get_cmdline_user_args():
+		if arg.begins_with("--iterations="):
+			iterations = int(arg.trim_prefix("--iterations="))
+		elif arg.begins_with("--filter="):
+			filter = arg.trim_prefix("--filter=")
+		elif arg.begins_with("--output="):
+			output_path = arg.trim_prefix("--output=")
+
+	var benchmarks = {}
+	for gdscript in DirAccess.get_files_at(BENCHMARK_DIR):
+		if not gdscript.ends_with(".gd"):
+			continue
+		var suite = load(str(BENCHMARK_DIR, "/", gdscript)).new()
+		for method in suite.get_method_list():
+			var method_name: String = method.name
+			if not method_name.begins_with("bench_"):
+				continue
+			var benchmark_name = str(gdscript.get_basename(), "/", method_name.trim_prefix("bench_"))
+			if filter and not filter in benchmark_name:
+				continue
+			benchmarks[benchmark_name] = _run_benchmark(suite, method_name)
+
+	var results = {
+		"runtime": LuaState.get_lua_runtime(),
+		"lua_version": LuaState.get_lua_version_string(),
+		"godot_version": Engine.get_version_info().string,
+		"iterations": iterations,
+		"samples": SAMPLES,
+		"benchmarks": benchmarks,
+	}
+	var json = JSON.stringify(results, "\t", false)
+	print(json)
+	if output_path:
+		var file = FileAccess.open(output_path, FileAccess.WRITE)
+		file.store_string(json)
+
+	quit(0)
+
+
+# Runs one warm-up pass and SAMPLES timed passes, reporting the median
+func _run_benchmark(suite: Object, method_name: String) -> Dictionary:
+	if suite.has_method("_setup"):
+		suite._setup()
+	suite.call(method_name, max(iterations / 10, 1))
+
+	var samples_usec = []
+	for i in SAMPLES:
+		var start = Time.get_ticks_usec()
+		suite.call(method_name, iterations)
+		samples_usec.append(Time.get_ticks_usec() - start)
+	samples_usec.sort()
+
+	var median_usec = samples_usec[SAMPLES / 2]
+	return {
+		"usec_per_op": float(median_usec) / iterations,
+		"ops_per_sec": iterations * 1000000.0 / max(median_usec, 1),
+		"samples_usec": samples_usec,
+	}
@@ -0,0 +1,77 @@
+extends RefCounted
+## Lua→Godot method calls and Godot→Lua function calls
+
+
+var lua_state: LuaState
+var lua_loops: LuaTable
+var lua_function: LuaFunction
+
+
+func _setup():
+	lua_state = LuaState.new()
+	lua_state.open_libraries()
+	lua_loops = lua_state.do_string("""
+		return {
+			builtin_method = function(n)
+				local v = Vector2(3, 4)
+				for i = 1, n do v:length() end
+			end,
+			builtin_method_with_args = function(n)
+				local s = String("hello world")
+				for i = 1, n do s:replace("world", "lua") end
+			end,
+			object_method = function(n)
+				local obj = RefCounted:new()
+				for i = 1, n do obj:get_reference_count() end
+			end,
+			singleton_method = function(n)
+				for i = 1, n do Time:get_ticks_usec() end
+			end,
+			utility_function = function(n)
+				for i = 1, n do absf(-1.5) end
+			end,
+			callable = function(n, callable)
+				for i = 1, n do callable(i) end
+			end,
+		}
+	""")
+	lua_function = lua_state.do_string("return function(x) return x end")
+
+
+func _echo(value):
+	return value
+
+
+func bench_lua_to_builtin_method(iterations: int):
+	lua_loops.builtin_method.invoke(iterations)
+
+
+func bench_lua_to_builtin_method_with_args(iterations: int):
+	lua_loops.builtin_method_with_args.invoke(iterations)
+
+
+func bench_lua_to_object_method(iterations: int):
+	lua_loops.object_method.invoke(iterations)
+
+
+func bench_lua_to_singleton_method(iterations: int):
+	lua_loops.singleton_method.invoke(iterations)
+
+
+func bench_lua_to_utility_function(iterations: int):
+	lua_loops.utility_function.invoke(iterations)
+
+
+func bench_lua_to_callable(iterations: int):
+	lua_loops.callable.invoke(iterations, _echo)
+
+
+func bench_godot_to_lua_function(iterations: int):
+	for i in iterations:
+		lua_function.invoke(i)
+
+
+func bench_godot_to_lua_callable(iterations: int):
+	var callable = lua_function.to_callable()
+	for i in iterations:
+		callable.call(i)
@@ -0,0 +1,60 @@
+extends RefCounted
+## Conversions between Lua tables and Dictionary/Array
+
+
+const SIZE = 16
+
+var lua_state: LuaState
+var lua_loops: LuaTable
+var dictionary = {}
+var table: LuaTable
+
+
+func _setup():
+	lua_state = LuaState.new()
+	lua_state.open_libraries()
+	for i in SIZE:
+		dictionary[str("key", i)] = i
+	table = lua_state.create_table(dictionary)
+	lua_loops = lua_state.load_string("""
+		local SIZE = ...
+		local t, dict = {}, {}
+		for i = 1, SIZE do
+			t[i] = i
+			dict["key" .. i] = i
+		end
+		return {
+			table_to_array = function(n)
+				for i = 1, n do Array(t) end
+			end,
+			table_to_dictionary = function(n)
+				for i = 1, n do Dictionary(dict) end
+			end,
+		}
+	""").invoke(SIZE)
+
+
+func bench_lua_table_to_array(iterations: int):
+	lua_loops.table_to_array.invoke(iterations)
+
+
+func bench_lua_table_to_dictionary(iterations: int):
+	lua_loops.table_to_dictionary.invoke(iterations)
+
+
+func bench_create_table_from_dictionary(iterations: int):
+	for i in iterations:
+		lua_state.create_table(dictionary)
+
+
+func bench_table_to_dictionary(iterations: int):
+	for i in iterations:
+		table.to_dictionary()
+
+
+func bench_table_to_array(iterations: int):
+	var array_table = lua_state.create_table()
+	for i in SIZE:
+		array_table.set(i + 1, i)
+	for i in iterations:
+		array_table.to_array()
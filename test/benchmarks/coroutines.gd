@@ -0,0 +1,63 @@
+extends RefCounted
+## Coroutine resume/yield and `await` round-trips
+
+
+signal resumed()
+
+var lua_state: LuaState
+var lua_loops: LuaTable
+var yielding_coroutine: LuaCoroutine
+
+
+func _setup():
+	lua_state = LuaState.new()
+	lua_state.open_libraries()
+	lua_loops = lua_state.do_string("""
+		return {
+			resume_yield = function(n)
+				local co = coroutine.wrap(function()
+					while true do coroutine.yield() end
+				end)
+				for i = 1, n do co() end
+			end,
+			await_signal = function(n, resource)
+				local co = coroutine.create(function()
+					while true do await(resource.changed) end
+				end)
+				coroutine.resume(co)
+				for i = 1, n do resource:emit_changed() end
+			end,
+			create_coroutine = function(n)
+				local f = function() end
+				for i = 1, n do coroutine.resume(coroutine.create(f)) end
+			end,
+		}
+	""")
+	yielding_coroutine = lua_state.do_string("""
+		return coroutine.create(function(value)
+			while true do value = coroutine.yield(value) end
+		end)
+	""")
+
+
+func bench_lua_resume_yield(iterations: int):
+	lua_loops.resume_yield.invoke(iterations)
+
+
+func bench_lua_await_signal(iterations: int):
+	lua_loops.await_signal.invoke(iterations, Resource.new())
+
+
+func bench_lua_create_coroutine(iterations: int):
+	lua_loops.create_coroutine.invoke(iterations)
+
+
+func bench_godot_resume(iterations: int):
+	for i in iterations:
+		yielding_coroutine.resume(i)
+
+
+func bench_godot_create_coroutine(iterations: int):
+	var f = lua_state.do_string("return function() end")
+	for i in iterations:
+		LuaCoroutine.create(f).resume()
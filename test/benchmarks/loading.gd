@@ -0,0 +1,43 @@
+extends RefCounted
+## `require` and chunk load times
+
+
+const MODULE_PATH = "res://benchmarks/lua_files/bench_module.lua"
+
+var lua_state: LuaState
+var require_uncached: LuaFunction
+var source: String
+
+
+func _setup():
+	lua_state = LuaState.new()
+	lua_state.open_libraries()
+	lua_state.package_path = "res://benchmarks/lua_files/?.lua"
+	require_uncached = lua_state.do_string("""
+		return function(n)
+			for i = 1, n do
+				package.loaded.bench_module = nil
+				require "bench_module"
+			end
+		end
+	""")
+	source = FileAccess.get_file_as_string(MODULE_PATH)
+
+
+func bench_require(iterations: int):
+	require_uncached.invoke(iterations)
+
+
+func bench_load_string(iterations: int):
+	for i in iterations:
+		lua_state.load_string(source, "bench_module")
+
+
+func bench_load_file(iterations: int):
+	for i in iterations:
+		lua_state.load_file(MODULE_PATH)
+
+
+func bench_new_state(iterations: int):
+	for i in iterations:
+		LuaState.new().open_libraries()
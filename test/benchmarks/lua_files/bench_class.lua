@@ -0,0 +1,21 @@
+local BenchClass = {}
+
+BenchClass.value = 0
+BenchClass.getter_value = property {
+	get = function(self)
+		return self.value
+	end,
+	set = function(self, value)
+		self.value = value
+	end,
+}
+
+function BenchClass:echo(value)
+	return value
+end
+
+function BenchClass:add(a, b)
+	return a + b
+end
+
+return BenchClass
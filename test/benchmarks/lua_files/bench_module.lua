@@ -0,0 +1,30 @@
+local M = {}
+
+function M.clamp(value, min, max)
+	if value < min then
+		return min
+	elseif value > max then
+		return max
+	else
+		return value
+	end
+end
+
+function M.lerp(from, to, weight)
+	return from + (to - from) * weight
+end
+
+function M.map(t, f)
+	local result = {}
+	for i, v in ipairs(t) do
+		result[i] = f(v)
+	end
+	return result
+end
+
+M.Vector = {
+	zero = Vector2(0, 0),
+	one = Vector2(1, 1),
+}
+
+return M
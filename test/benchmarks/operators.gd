@@ -0,0 +1,71 @@
+extends RefCounted
+## Variant operator metamethods called from Lua
+
+
+var lua_state: LuaState
+var lua_loops: LuaTable
+
+
+func _setup():
+	lua_state = LuaState.new()
+	lua_state.open_libraries()
+	lua_loops = lua_state.do_string("""
+		return {
+			add = function(n)
+				local v, one = Vector2(0, 0), Vector2(1, 1)
+				for i = 1, n do v = v + one end
+			end,
+			mul_scalar = function(n)
+				local v = Vector3(1, 2, 3)
+				for i = 1, n do local _ = v * 2 end
+			end,
+			eq = function(n)
+				local a, b = Vector2(1, 2), Vector2(1, 2)
+				for i = 1, n do local _ = a == b end
+			end,
+			lt = function(n)
+				local a, b = StringName("a"), StringName("b")
+				for i = 1, n do local _ = a < b end
+			end,
+			index = function(n)
+				local v = Vector2(1, 2)
+				for i = 1, n do local _ = v.x end
+			end,
+			newindex = function(n)
+				local v = Vector2(1, 2)
+				for i = 1, n do v.x = i end
+			end,
+			concat = function(n)
+				local s = String("a")
+				for i = 1, n do local _ = s .. "b" end
+			end,
+		}
+	""")
+
+
+func bench_add(iterations: int):
+	lua_loops.add.invoke(iterations)
+
+
+func bench_mul_scalar(iterations: int):
+	lua_loops.mul_scalar.invoke(iterations)
+
+
+func bench_eq(iterations: int):
+	lua_loops.eq.invoke(iterations)
+
+
+func bench_lt(iterations: int):
+	lua_loops.lt.invoke(iterations)
+
+
+func bench_index(iterations: int):
+	lua_loops.index.invoke(iterations)
+
+
+func bench_newindex(iterations: int):
+	lua_loops.newindex.invoke(iterations)
+
+
+func bench_concat(iterations: int):
+	lua_loops.concat.invoke(iterations)
@@ -0,0 +1,40 @@
+extends RefCounted
+## Godot→Lua `call_func` and property access on LuaScriptInstance
+
+
+var bench_class = load("res://benchmarks/lua_files/bench_class.lua")
+var obj
+
+
+func _setup():
+	obj = bench_class.new()
+
+
+func bench_call_method(iterations: int):
+	for i in iterations:
+		obj.echo(i)
+
+
+func bench_call_method_two_args(iterations: int):
+	for i in iterations:
+		obj.add(i, 1)
+
+
+func bench_call_dynamic(iterations: int):
+	for i in iterations:
+		obj.call(&"echo", i)
+
+
+func bench_property_get(iterations: int):
+	for i in iterations:
+		var _value = obj.value
+
+
+func bench_property_set(iterations: int):
+	for i in iterations:
+		obj.value = i
+
+
+func bench_property_getter_setter(iterations: int):
+	for i in iterations:
+		obj.getter_value = obj.getter_value + 1
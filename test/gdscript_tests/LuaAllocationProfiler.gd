@@ -0,0 +1,58 @@
+extends RefCounted
+
+
+func test_allocation_sites() -> bool:
+	# LuaJIT uses its builtin allocator, so allocations cannot be tracked
+	if LuaState.get_lua_runtime() == "luajit":
+		return true
+
+	var lua_state = LuaState.new()
+	lua_state.open_libraries()
+	var profiler = LuaAllocationProfiler.new()
+	profiler.start(lua_state, 1, 1)
+	var before = profiler.get_snapshot()
+	lua_state.do_string("""
+		retained = {}
+		for i = 1, 1000 do
+			retained[i] = { i }
+		end
+	""", "=allocating_chunk")
+	profiler.stop()
+
+	var diff = LuaAllocationProfiler.diff_snapshots(before, profiler.get_snapshot())
+	var chunk_sites = diff.keys().filter(func(site): return site.begins_with("allocating_chunk:"))
+	assert(not chunk_sites.is_empty())
+	var live_bytes = 0
+	var allocation_count = 0
+	for site in chunk_sites:
+		live_bytes += diff[site].live_bytes
+		allocation_count += diff[site].allocation_count
+	assert(live_bytes > 0)
+	assert(allocation_count >= 1000)
+	return true
+
+
+func test_with_sampling_profiler() -> bool:
+	if LuaState.get_lua_runtime() == "luajit":
+		return true
+
+	var lua_state = LuaState.new()
+	lua_state.open_libraries()
+	var allocation_profiler = LuaAllocationProfiler.new()
+	allocation_profiler.start(lua_state, 1, 1)
+	var sampling_profiler = LuaSamplingProfiler.new()
+	sampling_profiler.start(lua_state, 10)
+	lua_state.do_string("""
+		retained = {}
+		for i = 1, 1000 do
+			retained[i] = { i }
+		end
+	""", "=allocating_chunk")
+	sampling_profiler.stop()
+	allocation_profiler.stop()
+
+	# Both profilers share the state's hook
+	assert(sampling_profiler.get_sample_count() > 0)
+	var sites = allocation_profiler.get_snapshot().keys()
+	assert(sites.any(func(site): return site.begins_with("allocating_chunk:")))
+	return true
@@ -47,6 +47,29 @@ func test_callable() -> bool:
 	return true
 
 
+func test_invoke_error() -> bool:
+	var error_function = lua_state.do_string("return function(msg) error(msg, 0) end")
+	var result = error_function.invoke("failed")
+	assert(result is LuaError)
+	assert(result.message == "failed")
+	return true
+
+
+func test_lua_callable_signal() -> bool:
+	var callback = lua_state.do_string("""
+		local received = {}
+		return Callable(function(value) received[#received + 1] = value end), received
+	""")
+	var emitter = Object.new()
+	emitter.add_user_signal("fired")
+	emitter.connect("fired", callback[0])
+	emitter.emit_signal("fired", 1)
+	emitter.emit_signal("fired", 2)
+	emitter.free()
+	assert(callback[1].length() == 2)
+	return true
+
+
 func test_create_function() -> bool:
 	var callable = func(arg1):
 		return arg1
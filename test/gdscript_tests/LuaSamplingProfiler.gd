@@ -0,0 +1,73 @@
+extends RefCounted
+
+
+var lua_state: LuaState
+
+
+func _init():
+	lua_state = LuaState.new()
+	lua_state.open_libraries()
+	if LuaState.get_lua_runtime() == "luajit":
+		lua_state.do_string("jit.off()")
+
+
+func test_sampling() -> bool:
+	var profiler = LuaSamplingProfiler.new()
+	profiler.start(lua_state, 100)
+	assert(profiler.is_running())
+	lua_state.do_string("""
+		local function hot_function(n)
+			local s = 0
+			for i = 1, n do s = s + i end
+			return s
+		end
+		for i = 1, 100 do hot_function(1000) end
+	""", "profiled_chunk")
+	profiler.stop()
+	assert(not profiler.is_running())
+	assert(profiler.get_sample_count() > 0)
+
+	var folded = profiler.get_folded_stacks()
+	assert("hot_function" in folded)
+	assert("profiled_chunk" in folded)
+
+	var tree = profiler.get_tree()
+	assert(tree.name == "root")
+	assert(tree.total_samples == profiler.get_sample_count())
+	assert(not tree.children.is_empty())
+	return true
+
+
+func test_clear() -> bool:
+	var profiler = LuaSamplingProfiler.new()
+	profiler.start(lua_state, 10)
+	lua_state.do_string("for i = 1, 1000 do end")
+	profiler.stop()
+	assert(profiler.get_sample_count() > 0)
+	profiler.clear()
+	assert(profiler.get_sample_count() == 0)
+	assert(profiler.get_folded_stacks() == "")
+	assert(profiler.get_tree().is_empty())
+	return true
+
+
+func test_shared_hooks() -> bool:
+	var hook_calls = [0]
+	var call_hook = func(_debug): hook_calls[0] += 1
+	lua_state.main_thread.set_hook(call_hook, LuaThread.HOOK_MASK_CALL)
+
+	var profiler = LuaSamplingProfiler.new()
+	profiler.start(lua_state, 10)
+	var infinite_loop = lua_state.do_string("return function() while true do end end")
+	var result = lua_state.call_with_budget(infinite_loop, [], 10000)
+	lua_state.do_string("local function f() end for i = 1, 100 do f() end")
+	profiler.stop()
+
+	# Profiling, instruction budgets and thread hooks don't disable each other
+	assert(result is LuaError)
+	assert(profiler.get_sample_count() > 0)
+	assert(hook_calls[0] >= 100)
+	assert(lua_state.main_thread.get_hook() == call_hook)
+	assert(lua_state.main_thread.get_hook_mask() == LuaThread.HOOK_MASK_CALL)
+	lua_state.main_thread.set_hook(null, 0)
+	return true
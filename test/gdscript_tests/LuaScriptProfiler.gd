@@ -0,0 +1,31 @@
+extends RefCounted
+
+
+var test_class = load("res://gdscript_tests/lua_files/test_class.lua")
+
+
+func test_profile_script_methods() -> bool:
+	var obj = test_class.new()
+	LuaScriptLanguage.start_profiling()
+	for i in 3:
+		obj.delay_usec(1000)
+	LuaScriptLanguage.stop_profiling()
+
+	var data = LuaScriptLanguage.get_profiling_data()
+	var delay_data = data.filter(func(info): return info.signature.ends_with("::delay_usec"))
+	assert(delay_data.size() == 1)
+	assert(delay_data[0].signature.begins_with("res://gdscript_tests/lua_files/test_class.lua::"))
+	assert(delay_data[0].call_count == 3)
+	assert(delay_data[0].total_time >= 3000)
+	assert(delay_data[0].self_time >= 3000)
+	assert(delay_data[0].self_time <= delay_data[0].total_time)
+	return true
+
+
+func test_calls_are_not_recorded_while_stopped() -> bool:
+	var obj = test_class.new()
+	LuaScriptLanguage.start_profiling()
+	LuaScriptLanguage.stop_profiling()
+	obj.delay_usec(1)
+	assert(LuaScriptLanguage.get_profiling_data().is_empty())
+	return true
@@ -0,0 +1,96 @@
+extends RefCounted
+
+
+var pool: LuaStatePool
+
+
+func _setup():
+	pool = LuaStatePool.new()
+
+
+func test_prewarm() -> bool:
+	pool.prewarm(2)
+	assert(pool.get_available_count() == 2)
+	var lua_state = pool.acquire()
+	assert(lua_state is LuaState)
+	assert(pool.get_available_count() == 1)
+	pool.release(lua_state)
+	assert(pool.get_available_count() == 2)
+	return true
+
+
+func test_libraries() -> bool:
+	pool.libraries = LuaState.LUA_BASE
+	var lua_state = pool.acquire()
+	assert(lua_state.are_libraries_opened(LuaState.LUA_BASE))
+	assert(not lua_state.are_libraries_opened(LuaState.GODOT_VARIANT))
+	return true
+
+
+func test_release_restores_globals() -> bool:
+	var lua_state = pool.acquire()
+	lua_state.do_string("""
+		some_global = 42
+		print = nil
+		string.custom_function = function() end
+	""")
+	pool.release(lua_state)
+	lua_state = pool.acquire()
+	assert(lua_state.globals.some_global == null)
+	assert(lua_state.globals.print != null)
+	assert(lua_state.do_string("return string.custom_function") == null)
+	return true
+
+
+func test_release_restores_loaded_modules() -> bool:
+	var lua_state = pool.acquire()
+	lua_state.do_string("package.loaded.my_module = {}")
+	pool.release(lua_state)
+	lua_state = pool.acquire()
+	assert(lua_state.do_string("return package.loaded.my_module") == null)
+	return true
+
+
+func test_release_restores_settings() -> bool:
+	var lua_state = pool.acquire()
+	lua_state.memory_soft_limit = 1024 * 1024
+	lua_state.memory_limit = 2 * 1024 * 1024
+	lua_state.gc_frame_budget_usec = 100
+	lua_state.start_coverage()
+	lua_state.do_string("local x = 1")
+	pool.release(lua_state)
+	lua_state = pool.acquire()
+	assert(lua_state.memory_soft_limit == 0)
+	assert(lua_state.memory_limit == 0)
+	assert(lua_state.gc_frame_budget_usec == 0)
+	assert(not lua_state.is_coverage_running())
+	assert(lua_state.get_coverage().is_empty())
+	return true
+
+
+func test_max_size() -> bool:
+	pool.max_size = 1
+	var first = pool.acquire()
+	var second = pool.acquire()
+	pool.release(first)
+	pool.release(second)
+	assert(pool.get_available_count() == 1)
+	return true
+
+
+func test_release_twice() -> bool:
+	var lua_state = pool.acquire()
+	pool.release(lua_state)
+	pool.release(lua_state)
+	assert(pool.get_available_count() == 1)
+	return true
+
+
+func test_release_foreign_state() -> bool:
+	var lua_state = LuaState.new()
+	pool.release(lua_state)
+	assert(pool.get_available_count() == 0)
+	var other_pool = LuaStatePool.new()
+	pool.release(other_pool.acquire())
+	assert(pool.get_available_count() == 0)
+	return true
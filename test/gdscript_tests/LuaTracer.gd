@@ -0,0 +1,86 @@
+extends RefCounted
+
+
+var lua_state: LuaState
+
+
+func _setup():
+	lua_state = LuaState.new()
+	lua_state.open_libraries()
+	LuaTracer.clear()
+
+
+func test_trace_boundary_crossings() -> bool:
+	var f = lua_state.do_string("""
+		return function()
+			local v = Vector2(3, 4)
+			return v:length()
+		end
+	""")
+	LuaTracer.start()
+	assert(LuaTracer.is_running())
+	assert(f.invoke() == 5)
+	LuaTracer.stop()
+	assert(not LuaTracer.is_running())
+	assert(LuaTracer.get_event_count() >= 2)
+
+	var trace = JSON.parse_string(LuaTracer.get_trace_json())
+	var names = trace.traceEvents.map(func(event): return event.name)
+	assert("LuaFunction::invoke" in names)
+	assert("length" in names)
+	return true
+
+
+func test_not_running() -> bool:
+	var f = lua_state.do_string("return function() end")
+	f.invoke()
+	assert(LuaTracer.get_event_count() == 0)
+	return true
+
+
+func test_ring_buffer_overwrites_oldest() -> bool:
+	var f = lua_state.do_string("return function() end")
+	LuaTracer.start(4)
+	for i in 10:
+		f.invoke()
+	f.invokev([])
+	LuaTracer.stop()
+	assert(LuaTracer.get_event_count() == 4)
+
+	var trace = JSON.parse_string(LuaTracer.get_trace_json())
+	var names = trace.traceEvents.filter(func(event): return event.ph == "X").map(func(event): return event.name)
+	assert(names.size() == 4)
+	assert(names.back() == "LuaFunction::invokev")
+
+	# Shrinking existing buffers keeps the most recent events
+	LuaTracer.start(2)
+	LuaTracer.stop()
+	assert(LuaTracer.get_event_count() == 2)
+	trace = JSON.parse_string(LuaTracer.get_trace_json())
+	names = trace.traceEvents.filter(func(event): return event.ph == "X").map(func(event): return event.name)
+	assert(names == ["LuaFunction::invoke", "LuaFunction::invokev"])
+
+	LuaTracer.clear()
+	assert(LuaTracer.get_event_count() == 0)
+	LuaTracer.start()
+	LuaTracer.stop()
+	return true
+
+
+func test_exited_threads_keep_events() -> bool:
+	var f = lua_state.do_string("return function() end")
+	LuaTracer.start()
+	for i in 2:
+		var thread = Thread.new()
+		thread.start(func(): f.invoke())
+		thread.wait_to_finish()
+	LuaTracer.stop()
+
+	# The second thread reuses the buffer released by the first one, but events keep their own thread
+	var trace = JSON.parse_string(LuaTracer.get_trace_json())
+	var thread_ids = trace.traceEvents.filter(func(event): return event.ph == "X").map(func(event): return event.tid)
+	assert(thread_ids.size() == 2)
+	assert(thread_ids[0] != thread_ids[1])
+	var thread_names = trace.traceEvents.filter(func(event): return event.ph == "M")
+	assert(thread_names.size() == 2)
+	return true
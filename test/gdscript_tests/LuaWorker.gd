@@ -0,0 +1,86 @@
+extends RefCounted
+
+
+const TIMEOUT_MSEC = 5000
+
+
+func _wait_message(worker: LuaWorker) -> Variant:
+	var start_time = Time.get_ticks_msec()
+	while not worker.has_messages() and Time.get_ticks_msec() - start_time < TIMEOUT_MSEC:
+		OS.delay_msec(1)
+	return worker.poll()
+
+
+func test_post_and_poll() -> bool:
+	var worker = LuaWorker.new()
+	assert(worker.start("""
+		return function(message)
+			worker.post(message * 2)
+		end
+	""") == OK)
+	assert(worker.post(21))
+	assert(_wait_message(worker) == 42)
+	worker.stop()
+	assert(not worker.is_running())
+	return true
+
+
+func test_tables_become_dictionaries() -> bool:
+	var worker = LuaWorker.new()
+	worker.start("""
+		local message = worker.wait()
+		worker.post({ sum = message.a + message.b, list = { 1, 2, 3 } })
+	""")
+	worker.post({ "a": 1, "b": 2 })
+	var result = _wait_message(worker)
+	assert(result is Dictionary)
+	assert(result.sum == 3)
+	assert(result.list[1] == 1)
+	worker.stop()
+	return true
+
+
+func test_stop_interrupts_loop() -> bool:
+	var worker = LuaWorker.new()
+	worker.start("""
+		if jit then jit.off() end
+		worker.post(true)
+		while true do end
+	""")
+	assert(_wait_message(worker) == true)
+	worker.stop()
+	assert(not worker.is_running())
+	return true
+
+
+func test_stop_interrupts_coroutine() -> bool:
+	var worker = LuaWorker.new()
+	worker.start("""
+		if jit then jit.off() end
+		local co = coroutine.create(function()
+			worker.post(true)
+			while true do end
+		end)
+		-- Errors are caught by `resume`, so the loop runs again until it is interrupted outside the coroutine
+		while true do coroutine.resume(co) end
+	""")
+	assert(_wait_message(worker) == true)
+	worker.stop()
+	assert(not worker.is_running())
+	return true
+
+
+func test_restart_after_finishing() -> bool:
+	var worker = LuaWorker.new()
+	worker.start("return 1")
+	var start_time = Time.get_ticks_msec()
+	while worker.is_running() and Time.get_ticks_msec() - start_time < TIMEOUT_MSEC:
+		OS.delay_msec(1)
+	# The deferred `finished` callback of the first run was not called yet
+	assert(worker.start("""
+		worker.post(worker.wait() + 1)
+	""") == OK)
+	assert(worker.post(1))
+	assert(_wait_message(worker) == 2)
+	worker.stop()
+	return true
@@ -44,5 +44,28 @@ func test_await_gdscript_coroutine() -> bool:
 	return true
 
 
+func test_await_signal_in_loop() -> bool:
+	var lua = LuaState.new()
+	lua.open_libraries()
+
+	lua.globals.some_signal = some_signal
+	var coroutine = lua.do_string("""
+		return coroutine.create(function()
+			count = 0
+			while true do
+				await(some_signal)
+				count = count + 1
+			end
+		end)
+	""")
+	coroutine.resume()
+	for i in 3:
+		some_signal.emit()
+	assert(lua.globals.count == 3)
+	assert(coroutine.status == LuaCoroutine.STATUS_YIELD)
+
+	return true
+
+
 func _gdscript_coroutine():
 	await some_signal
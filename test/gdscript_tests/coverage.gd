@@ -0,0 +1,100 @@
+extends RefCounted
+
+
+const CHUNK = """local x = 0
+for i = 1, 3 do
+	x = x + i
+end
+if x < 0 then
+	x = -x
+end
+return x
+"""
+
+var lua_state: LuaState
+
+
+func _setup():
+	lua_state = LuaState.new()
+	lua_state.open_libraries()
+	if LuaState.get_lua_runtime() == "luajit":
+		lua_state.do_string("jit.off()")
+
+
+func test_line_hits() -> bool:
+	lua_state.start_coverage()
+	assert(lua_state.is_coverage_running())
+	assert(lua_state.do_string(CHUNK, "@coverage_test.lua") == 6)
+	lua_state.stop_coverage()
+	assert(not lua_state.is_coverage_running())
+
+	var lines = lua_state.get_coverage()["coverage_test.lua"]
+	assert(lines[1] == 1)
+	assert(lines[3] == 3)
+	assert(lines[6] == 0)
+	return true
+
+
+func test_lcov() -> bool:
+	lua_state.start_coverage()
+	lua_state.do_string(CHUNK, "@coverage_test.lua")
+	lua_state.stop_coverage()
+
+	var lcov = lua_state.get_coverage_lcov("coverage")
+	assert(lcov.begins_with("TN:coverage\nSF:coverage_test.lua\n"))
+	assert("DA:3,3\n" in lcov)
+	assert("DA:6,0\n" in lcov)
+	assert(lcov.ends_with("end_of_record\n"))
+	return true
+
+
+func test_clear() -> bool:
+	lua_state.start_coverage()
+	lua_state.do_string(CHUNK, "@coverage_test.lua")
+	lua_state.clear_coverage()
+	assert(lua_state.get_coverage().is_empty())
+	lua_state.stop_coverage()
+	return true
+
+
+func test_functions_on_same_line() -> bool:
+	lua_state.start_coverage()
+	lua_state.do_string("""local a, b = function() return 1 end, function()
+	return 2
+end
+return a() + b()
+""", "@same_line.lua")
+	lua_state.stop_coverage()
+
+	var lines = lua_state.get_coverage()["same_line.lua"]
+	assert(lines[1] >= 1)
+	assert(lines[2] == 1)
+	assert(lines[4] == 1)
+	return true
+
+
+func test_collected_chunks() -> bool:
+	lua_state.start_coverage()
+	# Chunks loaded from strings are collected, so their source addresses may be reused
+	for i in 20:
+		lua_state.do_string("return %d" % i, "@chunk_%d.lua" % i)
+		lua_state.collect_garbage()
+	lua_state.stop_coverage()
+
+	var coverage = lua_state.get_coverage()
+	for i in 20:
+		assert(coverage["chunk_%d.lua" % i][1] == 1)
+	return true
+
+
+func test_with_sampling_profiler() -> bool:
+	var profiler = LuaSamplingProfiler.new()
+	profiler.start(lua_state, 10)
+	lua_state.start_coverage()
+	lua_state.do_string(CHUNK, "@coverage_test.lua")
+	lua_state.stop_coverage()
+	profiler.stop()
+
+	assert(lua_state.get_coverage()["coverage_test.lua"][3] == 3)
+	assert(profiler.get_sample_count() > 0)
+	return true
@@ -0,0 +1,56 @@
+extends RefCounted
+
+
+func test_step_gc_with_budget() -> bool:
+	var lua_state = LuaState.new()
+	lua_state.open_libraries()
+	lua_state.do_string("""
+		for i = 1, 10000 do
+			local garbage = { i, tostring(i) }
+		end
+	""")
+	var elapsed = lua_state.step_gc_with_budget(1000)
+	assert(elapsed >= 0)
+	var stats = lua_state.get_gc_stats()
+	assert(stats.last_frame_usec == elapsed)
+	assert(stats.last_frame_steps > 0)
+	assert(stats.step_size_kilobytes >= 1)
+	return true
+
+
+func test_step_gc_with_invalid_budget() -> bool:
+	var lua_state = LuaState.new()
+	lua_state.open_libraries()
+	assert(lua_state.step_gc_with_budget(0) == 0)
+	assert(lua_state.step_gc_with_budget(-1) == 0)
+	assert(lua_state.get_gc_stats().last_frame_steps == 0)
+	return true
+
+
+func test_cycle_completes() -> bool:
+	var lua_state = LuaState.new()
+	lua_state.open_libraries()
+	lua_state.stop_gc()
+	lua_state.do_string("""
+		for i = 1, 10000 do
+			local garbage = { i, tostring(i) }
+		end
+	""")
+	var memory_before = lua_state.get_memory_used()
+	for i in 1000:
+		lua_state.step_gc_with_budget(1000)
+		if lua_state.get_gc_stats().completed_cycles > 0:
+			break
+	assert(lua_state.get_gc_stats().completed_cycles > 0)
+	assert(lua_state.get_memory_used() < memory_before)
+	return true
+
+
+func test_frame_budget() -> bool:
+	var lua_state = LuaState.new()
+	assert(lua_state.gc_frame_budget_usec == 0)
+	lua_state.gc_frame_budget_usec = 500
+	assert(lua_state.gc_frame_budget_usec == 500)
+	lua_state.gc_frame_budget_usec = -1
+	assert(lua_state.gc_frame_budget_usec == 0)
+	return true
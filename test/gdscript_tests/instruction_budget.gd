@@ -0,0 +1,84 @@
+extends RefCounted
+
+
+var lua_state: LuaState
+
+
+func _init():
+	lua_state = LuaState.new()
+	lua_state.open_libraries()
+	if LuaState.get_lua_runtime() == "luajit":
+		lua_state.do_string("jit.off()")
+
+
+func test_call_within_budget() -> bool:
+	var sum = lua_state.do_string("""
+		return function(n)
+			local s = 0
+			for i = 1, n do s = s + i end
+			return s
+		end
+	""")
+	assert(lua_state.call_with_budget(sum, [10], 10000) == 55)
+	return true
+
+
+func test_call_exceeds_budget() -> bool:
+	var infinite_loop = lua_state.do_string("""
+		return function()
+			while true do end
+		end
+	""")
+	var result = lua_state.call_with_budget(infinite_loop, [], 10000)
+	assert(result is LuaError)
+	assert("instruction budget exceeded" in result.message)
+	return true
+
+
+func test_pcall_cannot_catch_budget() -> bool:
+	var stubborn_loop = lua_state.do_string("""
+		return function()
+			while true do
+				pcall(function() while true do end end)
+			end
+		end
+	""")
+	var result = lua_state.call_with_budget(stubborn_loop, [], 10000)
+	assert(result is LuaError)
+	return true
+
+
+func test_yielded_call_keeps_budget() -> bool:
+	var yield_then_loop = lua_state.do_string("""
+		return function()
+			coroutine.yield()
+			while true do end
+		end
+	""")
+	var coroutine = lua_state.call_with_budget(yield_then_loop, [], 10000)
+	assert(coroutine is LuaCoroutine)
+	var result = coroutine.resume()
+	assert(result is LuaError)
+	assert("instruction budget exceeded" in result.message)
+	return true
+
+
+func test_coroutine_yields_when_budget_exhausted() -> bool:
+	var coroutine = lua_state.do_string("""
+		return coroutine.create(function(n)
+			local s = 0
+			for i = 1, n do s = s + i end
+			return s
+		end)
+	""")
+	var result = coroutine.resume_with_budget([100000], 1000)
+	assert(coroutine.is_instruction_budget_exhausted())
+	assert(coroutine.status == LuaThread.STATUS_YIELD)
+	var resume_count = 1
+	while coroutine.is_instruction_budget_exhausted():
+		result = coroutine.resume_with_budget([], 1000)
+		resume_count += 1
+	assert(resume_count > 1)
+	assert(result == 5000050000)
+	assert(coroutine.status == LuaThread.STATUS_DEAD)
+	return true
@@ -0,0 +1,48 @@
+extends RefCounted
+
+
+# Indexing a Variant calls a native metamethod, which aborts the trace
+const CHUNK = """local v = Vector2(1, 2)
+local x = 0
+for i = 1, 1000 do
+	x = x + v.x
+end
+return x
+"""
+
+var lua_state: LuaState
+
+
+func _setup():
+	lua_state = LuaState.new()
+	lua_state.open_libraries()
+
+
+func test_trace_aborts() -> bool:
+	if LuaState.get_lua_runtime() != "luajit":
+		return true
+
+	lua_state.start_jit_trace_diagnostics()
+	assert(lua_state.is_jit_trace_diagnostics_running())
+	assert(lua_state.do_string(CHUNK, "@jit_trace_test.lua") == 1000)
+	lua_state.stop_jit_trace_diagnostics()
+	assert(not lua_state.is_jit_trace_diagnostics_running())
+
+	var stats = lua_state.get_jit_trace_stats()
+	assert(stats.traces_aborted > 0)
+	var aborts = lua_state.get_jit_trace_aborts()
+	assert(aborts.keys().any(func(location): return location.begins_with("jit_trace_test.lua:")))
+	return true
+
+
+func test_clear() -> bool:
+	if LuaState.get_lua_runtime() != "luajit":
+		return true
+
+	lua_state.start_jit_trace_diagnostics()
+	lua_state.do_string(CHUNK, "@jit_trace_test.lua")
+	lua_state.clear_jit_trace_diagnostics()
+	assert(lua_state.get_jit_trace_aborts().is_empty())
+	assert(lua_state.get_jit_trace_stats().traces_aborted == 0)
+	lua_state.stop_jit_trace_diagnostics()
+	return true
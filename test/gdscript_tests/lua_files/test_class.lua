@@ -59,6 +59,10 @@ function TestClass:echo(value)
 	return value
 end
 
+function TestClass:delay_usec(usec)
+	OS:delay_usec(usec)
+end
+
 function TestClass:await_signal(sig)
 	await(sig)
 	self.signal_awaited = true
@@ -76,4 +80,9 @@ function TestClass:_signal_handler()
 	self.signal_handler_invoked = true
 end
 
+-- Overrides Object.get_meta_list when called by name
+function TestClass:get_meta_list()
+	return Array { "script_meta" }
+end
+
 return TestClass
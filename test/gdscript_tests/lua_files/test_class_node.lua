@@ -14,4 +14,11 @@ TestClassNode.rpc_config = {
 	rpc_method = rpc("any_peer", "call_local", "reliable", 0),
 }
 
+-- Handled before the engine property with the same name
+function TestClassNode:_get(name)
+	if name == "editor_description" then
+		return "from script"
+	end
+end
+
 return TestClassNode
@@ -0,0 +1,14 @@
+local ThreadClass = {}
+
+local calls = 0
+
+function ThreadClass:get_state_id()
+	return tostring(_G)
+end
+
+function ThreadClass:count_call()
+	calls = calls + 1
+	return calls
+end
+
+return ThreadClass
@@ -0,0 +1,82 @@
+extends RefCounted
+
+
+func test_memory_accounting() -> bool:
+	# LuaJIT uses its builtin allocator, so memory is not tracked
+	if LuaState.get_lua_runtime() == "luajit":
+		return true
+
+	var lua_state = LuaState.new()
+	lua_state.open_libraries()
+	var allocation_count = lua_state.get_allocation_count()
+	assert(allocation_count > 0)
+	assert(lua_state.get_memory_peak() >= lua_state.get_memory_used())
+	lua_state.do_string("local t = {} for i = 1, 100 do t[i] = {} end")
+	assert(lua_state.get_allocation_count() >= allocation_count + 100)
+	return true
+
+
+func test_memory_limit() -> bool:
+	# LuaJIT uses its builtin allocator, so memory is not tracked
+	if LuaState.get_lua_runtime() == "luajit":
+		return true
+
+	var lua_state = LuaState.new()
+	lua_state.open_libraries()
+	lua_state.memory_limit = lua_state.get_memory_used() + 64 * 1024
+	var result = lua_state.do_string("""
+		local t = {}
+		for i = 1, 1000000 do
+			t[i] = string.rep("x", 100) .. i
+		end
+	""")
+	assert(result is LuaError)
+	assert("not enough memory" in result.message)
+	assert(lua_state.get_failed_allocation_count() > 0)
+	assert(lua_state.get_memory_peak() <= lua_state.memory_limit)
+
+	# garbage is collected, so the state is still usable
+	lua_state.collect_garbage()
+	assert(lua_state.do_string("return 1 + 1") == 2)
+	return true
+
+
+func test_memory_soft_limit() -> bool:
+	# LuaJIT uses its builtin allocator, so memory is not tracked
+	if LuaState.get_lua_runtime() == "luajit":
+		return true
+
+	var lua_state = LuaState.new()
+	lua_state.open_libraries()
+	lua_state.stop_gc()
+	lua_state.memory_soft_limit = lua_state.get_memory_used() + 64 * 1024
+	var result = lua_state.do_string("""
+		for i = 1, 10000 do
+			local garbage = string.rep("x", 100) .. i
+		end
+		return true
+	""")
+	assert(result == true)
+	# soft limit collections kept memory usage close to the limit, even with the GC stopped
+	assert(lua_state.get_memory_used() < lua_state.memory_soft_limit + 64 * 1024)
+	return true
+
+
+func test_memory_soft_limit_never_fails_allocations() -> bool:
+	if LuaState.get_lua_runtime() == "luajit":
+		return true
+
+	var lua_state = LuaState.new()
+	lua_state.open_libraries()
+	lua_state.memory_soft_limit = lua_state.get_memory_used() + 1024
+	var failed_allocations = lua_state.get_failed_allocation_count()
+	var result = lua_state.do_string("""
+		local t = {}
+		for i = 1, 1000 do
+			t[i] = string.rep("x", 100) .. i
+		end
+		return #t
+	""")
+	assert(result == 1000)
+	assert(lua_state.get_failed_allocation_count() == failed_allocations)
+	return true
@@ -0,0 +1,88 @@
+extends RefCounted
+
+
+var lua_state: LuaState
+
+
+func _setup():
+	lua_state = LuaState.new()
+	lua_state.open_libraries()
+
+
+func test_float_array() -> bool:
+	var input = PackedFloat64Array()
+	input.resize(10000)
+	for i in input.size():
+		input[i] = i
+	var output = lua_state.parallel_map("""
+		return function(value, index)
+			return value * 2 + index
+		end
+	""", input, 100)
+	assert(output is PackedFloat64Array)
+	assert(output.size() == input.size())
+	for i in output.size():
+		assert(output[i] == i * 3)
+	return true
+
+
+func test_vector_array() -> bool:
+	var output = lua_state.parallel_map("""
+		return function(value)
+			return value * 2
+		end
+	""", PackedVector2Array([Vector2(1, 2), Vector2(3, 4)]), 1)
+	assert(output == PackedVector2Array([Vector2(2, 4), Vector2(6, 8)]))
+	return true
+
+
+func test_invalid_result() -> bool:
+	var output = lua_state.parallel_map("""
+		return function(value)
+			return "not a number"
+		end
+	""", PackedInt32Array([1, 2, 3]))
+	assert(output is LuaError)
+	return true
+
+
+func test_syntax_error() -> bool:
+	var output = lua_state.parallel_map("return function(", PackedInt32Array([1]))
+	assert(output is LuaError)
+	assert(output.status == LuaError.SYNTAX)
+	return true
+
+
+func test_out_of_range_result() -> bool:
+	var output = lua_state.parallel_map("""
+		return function(value)
+			return value + 255
+		end
+	""", PackedByteArray([0, 1]))
+	assert(output is LuaError)
+	return true
+
+
+func test_fresh_globals() -> bool:
+	var source = """
+		return function(value)
+			local previous = counter or 0
+			counter = previous + 1
+			return previous
+		end
+	"""
+	var output = lua_state.parallel_map(source, PackedInt32Array([0]))
+	assert(output == PackedInt32Array([0]))
+	output = lua_state.parallel_map(source, PackedInt32Array([0]))
+	assert(output == PackedInt32Array([0]))
+	return true
+
+
+func test_huge_chunk_size() -> bool:
+	var output = lua_state.parallel_map("""
+		return function(value)
+			return value + 1
+		end
+	""", PackedInt64Array([1, 2, 3]), 9223372036854775807)
+	assert(output == PackedInt64Array([2, 3, 4]))
+	return true
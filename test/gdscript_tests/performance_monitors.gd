@@ -0,0 +1,38 @@
+extends RefCounted
+
+
+func test_script_language_monitors() -> bool:
+	assert(Performance.has_custom_monitor("Lua/Memory (bytes)"))
+	assert(Performance.get_custom_monitor("Lua/Memory (bytes)") > 0)
+	assert(Performance.has_custom_monitor("Lua/Calls From Godot"))
+	assert(Performance.has_custom_monitor("Lua/Calls To Godot"))
+	return true
+
+
+func test_lua_state_monitors() -> bool:
+	var lua_state = LuaState.new()
+	lua_state.open_libraries()
+	lua_state.add_performance_monitors("test")
+	assert(Performance.get_custom_monitor("Lua (test)/Memory (bytes)") > 0)
+
+	lua_state.do_string("for i = 1, 1000 do local t = {} end")
+	lua_state.step_gc_with_budget(1000)
+	assert(Performance.get_custom_monitor("Lua (test)/GC Steps") == lua_state.get_gc_stats().last_frame_steps)
+	assert(Performance.get_custom_monitor("Lua (test)/GC Time (usec)") == lua_state.get_gc_stats().last_frame_usec)
+
+	# Monitors read values published by the thread running the state
+	lua_state.call_with_budget(lua_state.do_string("return function() end"), [], 1000)
+	assert(Performance.get_custom_monitor("Lua (test)/Coroutine Pool Size") == 1)
+
+	lua_state.remove_performance_monitors()
+	assert(not Performance.has_custom_monitor("Lua (test)/Memory (bytes)"))
+	return true
+
+
+func test_lua_state_monitors_removed_when_freed() -> bool:
+	var lua_state = LuaState.new()
+	lua_state.add_performance_monitors("freed")
+	assert(Performance.has_custom_monitor("Lua (freed)/Coroutine Pool Size"))
+	lua_state = null
+	assert(not Performance.has_custom_monitor("Lua (freed)/Coroutine Pool Size"))
+	return true
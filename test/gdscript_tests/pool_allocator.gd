@@ -0,0 +1,40 @@
+extends RefCounted
+
+
+func test_default_allocator() -> bool:
+	var lua_state = LuaState.new()
+	assert(lua_state.allocator == LuaState.ALLOCATOR_DEFAULT)
+	assert(lua_state.get_allocator_stats().is_empty())
+	return true
+
+
+func test_pool_allocator() -> bool:
+	var lua_state = LuaState.create(LuaState.ALLOCATOR_POOL)
+	lua_state.open_libraries()
+	var result = lua_state.do_string("""
+		local t = {}
+		for i = 1, 1000 do
+			t[i] = { tostring(i) }
+		end
+		t = nil
+		collectgarbage()
+		local s = 0
+		for i = 1, 1000 do
+			s = s + #{ i, i * 2 }
+		end
+		return s
+	""")
+	assert(result == 2000)
+	if LuaState.get_lua_runtime() == "luajit":
+		assert(lua_state.allocator == LuaState.ALLOCATOR_DEFAULT)
+		return true
+
+	assert(lua_state.allocator == LuaState.ALLOCATOR_POOL)
+	var stats = lua_state.get_allocator_stats()
+	assert(stats.small_allocations > 0)
+	assert(stats.pool_hits > 0)
+	assert(stats.hit_rate > 0.0 and stats.hit_rate <= 1.0)
+	assert(stats.reserved_bytes >= stats.used_bytes)
+	assert(stats.used_bytes >= stats.requested_bytes)
+	assert(stats.fragmentation >= 0.0 and stats.fragmentation < 1.0)
+	return true
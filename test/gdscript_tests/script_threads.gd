@@ -0,0 +1,29 @@
+extends RefCounted
+
+
+var thread_class = load("res://gdscript_tests/lua_files/thread_class.lua")
+
+
+func test_thread_uses_separate_state() -> bool:
+	var obj = thread_class.new()
+	var main_state_id = obj.get_state_id()
+	var thread = Thread.new()
+	thread.start(obj.get_state_id)
+	var thread_state_id = thread.wait_to_finish()
+	assert(thread_state_id is String)
+	assert(thread_state_id != main_state_id)
+	assert(obj.get_state_id() == main_state_id)
+	return true
+
+
+func test_module_locals_are_per_thread() -> bool:
+	var obj = thread_class.new()
+	var main_calls = obj.count_call()
+	var thread = Thread.new()
+	thread.start(func():
+		obj.count_call()
+		return obj.count_call()
+	)
+	assert(thread.wait_to_finish() == 2)
+	assert(obj.count_call() == main_calls + 1)
+	return true
@@ -146,3 +146,14 @@ func test_get_method_list() -> bool:
 	assert(methods.any(func(mi): return mi.name == "get_a"))
 	assert(methods.any(func(mi): return mi.name == "await_signal"))
 	return true
+
+
+func test_script_method_overrides_engine_method_in_lua() -> bool:
+	var obj = test_class.new()
+	var lua_state = LuaState.new()
+	lua_state.open_libraries()
+	lua_state.globals.obj = obj
+	assert(lua_state.do_string("return obj:get_meta_list()") == ["script_meta"])
+	# Engine methods that are not overridden are still available
+	assert(lua_state.do_string("return obj:get_class()") == "RefCounted")
+	return true
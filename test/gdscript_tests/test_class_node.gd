@@ -9,3 +9,39 @@ func test_rpc_call() -> bool:
 	obj.rpc("rpc_method")
 	assert(obj.rpc_called)
 	return true
+
+
+func test_script_get_overrides_engine_property_in_lua() -> bool:
+	var obj = test_class_node.new()
+	var lua_state = LuaState.new()
+	lua_state.open_libraries()
+	lua_state.globals.obj = obj
+	assert(obj.get("editor_description") == "from script")
+	assert(lua_state.do_string("return obj.editor_description") == "from script")
+	obj.free()
+	return true
+
+
+func test_engine_property_accessors_used_with_script() -> bool:
+	var script = GDScript.new()
+	script.source_code = "extends Node2D\n"
+	script.reload()
+	var obj = Node2D.new()
+	obj.set_script(script)
+	var lua_state = LuaState.new()
+	lua_state.open_libraries()
+	lua_state.globals.obj = obj
+
+	LuaTracer.clear()
+	LuaTracer.start()
+	lua_state.do_string("obj.position = obj.position + Vector2(1, 2)")
+	LuaTracer.stop()
+	assert(obj.position == Vector2(1, 2))
+	# Properties accessed through their cached getter and setter are traced with their own sites
+	var trace = JSON.parse_string(LuaTracer.get_trace_json())
+	var sites = trace.traceEvents.filter(func(event): return event.name == "position").map(func(event): return event.args.site)
+	assert("object_property_get" in sites)
+	assert("object_property_set" in sites)
+	LuaTracer.clear()
+	obj.free()
+	return true
@@ -0,0 +1,24 @@
+extends RefCounted
+
+
+const TASK_COUNT = 8
+
+
+func test_independent_states_in_worker_threads() -> bool:
+	var results = []
+	results.resize(TASK_COUNT)
+	var task = func(index: int):
+		var lua_state = LuaState.new()
+		lua_state.open_libraries()
+		var table = lua_state.do_string("""
+			local t = {}
+			for i = 1, 1000 do
+				t[i] = Vector2(i, i)
+			end
+			return t
+		""")
+		results[index] = table.length()
+	var group_id = WorkerThreadPool.add_group_task(task, TASK_COUNT)
+	WorkerThreadPool.wait_for_group_task_completion(group_id)
+	assert(results.all(func(result): return result == 1000))
+	return true
@@ -0,0 +1,42 @@
+local v = Vector2(3, 4)
+assert(v:length() == 5)
+assert(v:dot(Vector2(1, 0)) == 3)
+assert(v:rotated(0) == v)
+assert(Vector2.length(v) == 5)
+assert(Vector2i(3, 4):length() == 5)
+
+-- String methods work on Lua strings
+assert(("Hello"):begins_with("He"))
+
+-- String Variants use the typed binding
+local s = String("hello")
+assert(s:find("l", 3) == 3)
+assert(s:find("l", 0) == 2)
+
+-- String and StringName Variants are accepted as String arguments
+assert(s:begins_with(String("he")))
+assert(s:begins_with(StringName("he")))
+assert(("hello"):find(String("l")) == 2)
+
+-- Float arguments accept integers
+assert(v:rotated(0):is_equal_approx(v))
+assert(v:distance_to(Vector2(3, 0)) == 4)
+
+-- Omitted default arguments use the generic call path
+assert(s:find("l") == 2)
+assert(s:substr(1) == "ello")
+assert(v:snapped(Vector2(1, 1)) == v)
+
+-- Methods are still bound to their Variant
+local length = v.length
+assert(length(v) == 5)
+local dict = Dictionary()
+dict.length = v.length
+assert(dict.length:get_method() == "length")
+assert(dict.length:call() == 5)
+
+-- Calling with '.' instead of ':' is an error
+assert(not pcall(function() return v.length() end))
+
+-- Invalid arguments raise errors
+assert(not pcall(v.dot, v, "not a vector"))
@@ -10,3 +10,16 @@ assert(a == 6 and result == 6)
 custom_callable = custom_callable:bind(1)
 custom_callable()
 assert(a == 7)
+
+-- Lua function Callables are equal if they wrap the same function
+local function on_renamed() end
+assert(Callable(on_renamed) == Callable(on_renamed))
+assert(Callable(on_renamed):hash() == Callable(on_renamed):hash())
+assert(Callable(on_renamed) ~= Callable(function() end))
+
+local node = Node:new()
+node:connect("renamed", Callable(on_renamed))
+assert(node:is_connected("renamed", Callable(on_renamed)))
+node:disconnect("renamed", Callable(on_renamed))
+assert(not node:is_connected("renamed", Callable(on_renamed)))
+node:free()
@@ -4,3 +4,19 @@ assert(Object.__invalid_constant == nil, "Invalid constant did not return nil")
 
 assert(Node.NOTIFICATION_POSTINITIALIZE ~= nil, "Could not find integer constant from superclass")
 assert(Node.CONNECT_DEFERRED ~= nil, "Could not find enum constant from superclass")
+
+-- Repeated lookups return the same value
+local notification_ready = Node.NOTIFICATION_READY
+assert(notification_ready ~= nil, "Could not find constant")
+assert(Node.NOTIFICATION_READY == notification_ready, "Repeated lookup changed the constant")
+
+-- Misses keep resolving to nil and don't shadow constants of other classes
+assert(Object.__invalid_constant == nil, "Repeated miss did not return nil")
+assert(Object.NOTIFICATION_READY == nil, "Subclass constant found in superclass")
+assert(Node.NOTIFICATION_READY == notification_ready, "Miss in superclass shadowed subclass constant")
+
+-- Classes looked up again resolve the same constants
+local node_class = Node
+Node = nil
+assert(not rawequal(Node, node_class), "Class was not looked up again")
+assert(Node.NOTIFICATION_READY == notification_ready, "Class looked up again did not find the constant")
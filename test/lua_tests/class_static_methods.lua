@@ -1,2 +1,13 @@
 assert(DirAccess.get_open_error, "Could not access DirAccess.get_open_error static method")
 assert(DirAccess:get_open_error(), "Could not call DirAccess.get_open_error static method")
+
+-- Repeated lookups return the same method bind
+local get_open_error = DirAccess.get_open_error
+assert(rawequal(DirAccess.get_open_error, get_open_error), "Repeated lookup returned a different method bind")
+assert(get_open_error(DirAccess), "Could not call cached DirAccess.get_open_error method bind")
+
+-- Misses still resolve to nil and don't shadow methods of other classes
+assert(DirAccess.__invalid_method == nil, "Invalid method did not return nil")
+assert(DirAccess.__invalid_method == nil, "Repeated miss did not return nil")
+assert(Object.get_open_error == nil, "Subclass method found in superclass")
+assert(rawequal(DirAccess.get_open_error, get_open_error), "Miss in superclass shadowed subclass method")
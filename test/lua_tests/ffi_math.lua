@@ -0,0 +1,39 @@
+-- FFI math types are only available in LuaJIT
+local ok, ffi_math = pcall(require, "godot.ffi_math")
+if not ok then
+	return
+end
+
+local a = ffi_math.Vector2(1, 2)
+local b = ffi_math.Vector2(3, 4)
+assert(a + b == ffi_math.Vector2(4, 6))
+assert(b - a == ffi_math.Vector2(2, 2))
+assert(a * 2 == ffi_math.Vector2(2, 4))
+assert(-a == ffi_math.Vector2(-1, -2))
+assert(a:dot(b) == 11)
+assert(ffi_math.Vector2(3, 4):length() == 5)
+
+local ffi = require "ffi"
+
+-- cdata is converted to Variant when passed to Godot
+local array = Array()
+array:append(ffi_math.Vector2(5, 6))
+assert(typeof(array:back()) == TYPE_VECTOR2)
+assert(Vector2(1, 1):distance_to(ffi_math.Vector2(4, 5)) == 5)
+
+-- Values returned by Godot arrive as cdata
+local returned = array:back()
+assert(ffi.istype(ffi_math.Vector2, returned))
+assert(returned == ffi_math.Vector2(5, 6))
+
+-- Methods not implemented in Lua are called on a Variant copy
+assert(tostring(ffi_math.Vector2(-1, 2):abs()) == tostring(Vector2(1, 2)))
+
+-- Integer vectors only use integer math in Lua
+local i = ffi_math.Vector3i(1, 2, 3)
+assert(i * 2 == ffi_math.Vector3i(2, 4, 6))
+
+-- Transforms
+local t = ffi_math.Transform3D({ rows = { { 1, 0, 0 }, { 0, 1, 0 }, { 0, 0, 1 } } }, { 1, 2, 3 })
+assert(t * ffi_math.Vector3(1, 1, 1) == ffi_math.Vector3(2, 3, 4))
+assert(t:affine_inverse() * t == ffi_math.Transform3D({ rows = { { 1, 0, 0 }, { 0, 1, 0 }, { 0, 0, 1 } } }, { 0, 0, 0 }))
@@ -0,0 +1,40 @@
+-- FFI views are only available in LuaJIT with the FFI library opened
+local floats = PackedFloat32Array{ 1, 2, 3 }
+if not floats.ffi_view or not package.loaded.ffi then
+	return
+end
+
+local size = floats:ffi_view(function(view)
+	for i = 0, view.size - 1 do
+		view.data[i] = view.data[i] * 2
+	end
+	return view.size
+end)
+assert(size == 3)
+assert(floats == PackedFloat32Array{ 2, 4, 6 })
+
+-- Vectors are viewed as flat arrays of components
+local vectors = PackedVector2Array{ Vector2(1, 2), Vector2(3, 4) }
+vectors:ffi_view(function(view)
+	assert(view.size == 4)
+	view.data[3] = 10
+end)
+assert(vectors[1] == Vector2(3, 10))
+
+-- Views are invalidated after the callback returns
+local kept_view
+PackedByteArray{ 1, 2, 3 }:ffi_view(function(view)
+	kept_view = view
+end)
+assert(kept_view.size == 0)
+
+-- Resizing while viewing keeps the viewed memory alive and raises an error afterwards
+local resized = PackedInt32Array{ 1, 2, 3 }
+local ok, err = pcall(resized.ffi_view, resized, function(view)
+	resized:resize(1000)
+	view.data[2] = 10
+end)
+assert(not ok)
+assert(err:find("resized"))
+assert(resized:size() == 1000)
+assert(resized[2] == 3)
@@ -0,0 +1,21 @@
+local node = Node:new()
+
+-- Engine methods are called with cached MethodBinds
+node:set_name("Test")
+assert(node:get_name() == "Test")
+assert(node:get_instance_id() == node:get_instance_id())
+
+-- Methods from base classes and default arguments
+local child = Node:new()
+node:add_child(child)
+assert(node:get_child_count() == 1)
+assert(child:get_parent() == node)
+
+-- Vararg methods
+node:call("set_name", "Other")
+assert(node.name == "Other")
+
+-- Invalid calls raise errors
+assert(not pcall(node.set_name, node))
+
+node:free()
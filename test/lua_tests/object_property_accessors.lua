@@ -0,0 +1,27 @@
+local node = Node2D:new()
+
+-- Engine properties use cached getter and setter MethodBinds
+node.position = Vector2(1, 2)
+assert(node.position == Vector2(1, 2))
+assert(node:get_position() == Vector2(1, 2))
+node.rotation = 0.5
+assert(node.rotation == 0.5)
+
+-- Properties from base classes
+node.name = "Test"
+assert(node.name == "Test")
+node.visible = false
+assert(node.visible == false)
+
+-- Indexed properties
+local control = Control:new()
+control.offset_left = 10
+assert(control.offset_left == 10)
+assert(control:get_offset(SIDE_LEFT) == 10)
+
+-- Invalid values raise errors
+assert(not pcall(function() node.position = "invalid" end))
+assert(not pcall(function() node.unknown_property = 1 end))
+
+control:free()
+node:free()
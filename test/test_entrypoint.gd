@@ -2,19 +2,31 @@ extends SceneTree
 
 const LUA_TEST_DIR = "res://lua_tests"
 const GDSCRIPT_TEST_DIR = "res://gdscript_tests"
+# Pass "-- --lua-coverage=<path>" to write line coverage of Lua tests as an LCOV tracefile
+const COVERAGE_ARG = "--lua-coverage="
 
 func _process(_delta):
 	var all_success = true
 
 	print("Starting Lua GDExtension tests (runtime: ", LuaState.get_lua_runtime(), ")")
+	var coverage_path = ""
+	for arg in OS.get_cmdline_user_args():
+		if arg.begins_with(COVERAGE_ARG):
+			coverage_path = arg.trim_prefix(COVERAGE_ARG)
+	var coverage_lcov = ""
 	for lua_script in DirAccess.get_files_at(LUA_TEST_DIR):
 		if lua_script.ends_with(".uid"):
 			continue
 		var lua_state = LuaState.new()
 		lua_state.open_libraries()
 		
+		if coverage_path:
+			lua_state.start_coverage()
+		
 		var file_name = str(LUA_TEST_DIR, "/", lua_script)
 		var result = lua_state.do_file(file_name)
+		if coverage_path:
+			coverage_lcov += lua_state.get_coverage_lcov(lua_script.get_basename())
 		if result is LuaError:
 			all_success = false
 			print("! ", lua_script)
@@ -22,6 +34,11 @@ func _process(_delta):
 		else:
 			print("✓ ", lua_script)
 
+	if coverage_path:
+		var coverage_file = FileAccess.open(coverage_path, FileAccess.WRITE)
+		coverage_file.store_string(coverage_lcov)
+		print("Lua coverage written to ", coverage_path)
+
 	for gdscript in DirAccess.get_files_at(GDSCRIPT_TEST_DIR):
 		if gdscript.ends_with(".uid"):
 			continue
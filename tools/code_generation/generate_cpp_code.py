@@ -8,11 +8,37 @@ DEST_DIR = os.path.join(SRC_DIR, "generated")
 API_JSON_PATH = os.path.join(SRC_DIR, "..", "lib", "godot-cpp", "gdextension", "extension_api.json")
 PACKAGE_SEARCHER_SRC = os.path.join(SRC_DIR, "luaopen", "package_searcher.lua")
 LUA_SCRIPT_GLOBALS_SRC = os.path.join(SRC_DIR, "script-language", "globals.lua")
+FFI_VIEWS_SRC = os.path.join(SRC_DIR, "luaopen", "ffi_views.lua")
+FFI_MATH_SRC = os.path.join(SRC_DIR, "luaopen", "ffi_math.lua")
 PRIMITIVE_VARIANTS = [
     "bool",
     "int",
     "float",
 ]
+# Builtin types that are read from Lua and pushed back by typed builtin method bindings
+BUILTIN_METHOD_TYPES = {
+    "float": "double",
+    "int": "int64_t",
+    "bool": "bool",
+    "String": "String",
+    "Vector2": "Vector2",
+    "Vector2i": "Vector2i",
+    "Rect2": "Rect2",
+    "Rect2i": "Rect2i",
+    "Vector3": "Vector3",
+    "Vector3i": "Vector3i",
+    "Transform2D": "Transform2D",
+    "Vector4": "Vector4",
+    "Vector4i": "Vector4i",
+    "Plane": "Plane",
+    "Quaternion": "Quaternion",
+    "AABB": "AABB",
+    "Basis": "Basis",
+    "Transform3D": "Transform3D",
+    "Projection": "Projection",
+    "Color": "Color",
+}
+BUILTIN_METHOD_RECEIVERS = [t for t in BUILTIN_METHOD_TYPES if t not in PRIMITIVE_VARIANTS]
 UTILITY_FUNCTION_MAP = {
     "print": None,
     "typeof": None,
@@ -56,12 +82,12 @@ def generate_enums(global_enums):
     return " \\\n".join(lines) + "\n"
 
 
-def generate_package_searcher():
+def _generate_lua_source_string(variable_name, source_path):
     lines = [
         "// This file was automatically generated by generate_cpp_code.py",
-        "const char package_searcher_lua[] = ",
+        f"const char {variable_name}[] = ",
     ]
-    with open(PACKAGE_SEARCHER_SRC, "r", encoding="utf-8") as f:
+    with open(source_path, "r", encoding="utf-8") as f:
         for line in f:
             line = line.replace("\\", "\\\\").replace('"', '\\"').rstrip("\r\n")
             lines.append('"' + line + '\\n"')
@@ -69,16 +95,100 @@ def generate_package_searcher():
     return "\n".join(lines)
 
 
+def generate_package_searcher():
+    return _generate_lua_source_string("package_searcher_lua", PACKAGE_SEARCHER_SRC)
+
+
 def generate_lua_script_globals():
+    return _generate_lua_source_string("lua_script_globals", LUA_SCRIPT_GLOBALS_SRC)
+
+
+def generate_ffi_views():
+    return _generate_lua_source_string("ffi_views_lua", FFI_VIEWS_SRC)
+
+
+def generate_ffi_math():
+    return _generate_lua_source_string("ffi_math_lua", FFI_MATH_SRC)
+
+
+def generate_builtin_method_binds(builtin_classes):
     lines = [
         "// This file was automatically generated by generate_cpp_code.py",
-        "const char lua_script_globals[] = ",
+        "namespace luagdextension {",
+        "",
+        "static void register_builtin_method_binds(BuiltinMethodMap *methods) {",
     ]
-    with open(LUA_SCRIPT_GLOBALS_SRC, "r", encoding="utf-8") as f:
-        for line in f:
-            line = line.replace("\\", "\\\\").replace('"', '\\"').rstrip("\r\n")
-            lines.append('"' + line + '\\n"')
-    lines.append(";")
+    for cls in builtin_classes:
+        if cls["name"] not in BUILTIN_METHOD_RECEIVERS:
+            continue
+        variant_type = _to_variant_type(cls["name"])
+        for method in cls.get("methods", []):
+            # Only const methods are bound, so receivers can be passed without copying them back
+            if (
+                method.get("is_vararg", False)
+                or method.get("is_static", False)
+                or not method.get("is_const", False)
+                or "hash" not in method
+            ):
+                continue
+            return_type = method.get("return_type")
+            arg_types = [arg["type"] for arg in method.get("arguments", [])]
+            if (return_type is not None and return_type not in BUILTIN_METHOD_TYPES) or any(t not in BUILTIN_METHOD_TYPES for t in arg_types):
+                continue
+            template_args = [
+                variant_type,
+                BUILTIN_METHOD_TYPES[cls["name"]],
+                f'"{method["name"]}"',
+                str(method["hash"]),
+                BUILTIN_METHOD_TYPES[return_type] if return_type else "void",
+                *(BUILTIN_METHOD_TYPES[t] for t in arg_types),
+            ]
+            lines.append(f'\tmethods[{variant_type}].insert("{method["name"]}", &call_builtin_method<{", ".join(template_args)}>);')
+    lines.extend([
+        "}",
+        "",
+        "}",
+    ])
+    return "\n".join(lines) + "\n"
+
+
+def generate_method_bind_hashes(classes):
+    lines = [
+        "// This file was automatically generated by generate_cpp_code.py",
+        "#include <cstdint>",
+        "",
+        "struct MethodBindHash {",
+        "\tconst char *class_name;",
+        "\tconst char *method_name;",
+        "\tint64_t hash;",
+        "};",
+        "",
+        "// Engine object methods, used for getting their MethodBinds with `classdb_get_method_bind`",
+        "static const MethodBindHash method_bind_hashes[] = {",
+    ]
+    for cls in classes:
+        for method in cls.get("methods", []):
+            if method.get("is_virtual", False) or method.get("is_static", False) or "hash" not in method:
+                continue
+            lines.append(f'\t{{ "{cls["name"]}", "{method["name"]}", {method["hash"]} }},')
+    lines.append("};")
+    lines.extend([
+        "",
+        "struct PropertyAccessorNames {",
+        "\tconst char *class_name;",
+        "\tconst char *property_name;",
+        "\tconst char *getter;",
+        "\tconst char *setter;",
+        "\tint64_t index;",
+        "};",
+        "",
+        "// Engine object properties, with -1 as index for properties without one",
+        "static const PropertyAccessorNames property_accessor_names[] = {",
+    ])
+    for cls in classes:
+        for prop in cls.get("properties", []):
+            lines.append(f'\t{{ "{cls["name"]}", "{prop["name"]}", "{prop.get("getter", "")}", "{prop.get("setter", "")}", {prop.get("index", -1)} }},')
+    lines.append("};")
     return "\n".join(lines)
 
 
@@ -152,6 +262,22 @@ def main():
         code = generate_lua_script_globals()
         f.write(code)
     
+    with open(os.path.join(DEST_DIR, "ffi_views.h"), "w") as f:
+        code = generate_ffi_views()
+        f.write(code)
+    
+    with open(os.path.join(DEST_DIR, "ffi_math.h"), "w") as f:
+        code = generate_ffi_math()
+        f.write(code)
+    
+    with open(os.path.join(DEST_DIR, "builtin_method_binds.hpp"), "w") as f:
+        code = generate_builtin_method_binds(api["builtin_classes"])
+        f.write(code)
+    
+    with open(os.path.join(DEST_DIR, "method_bind_hashes.h"), "w") as f:
+        code = generate_method_bind_hashes(api["classes"])
+        f.write(code)
+    
     with open(os.path.join(DEST_DIR, "variant_type_constants.hpp"), "w") as f:
         code = generate_variant_type_constants(api["builtin_classes"])
         f.write(code)
@@ -14,12 +14,18 @@ def generate(env):
             "src/generated/utility_functions.hpp",
             "src/generated/package_searcher.h",
             "src/generated/lua_script_globals.h",
+            "src/generated/ffi_views.h",
+            "src/generated/ffi_math.h",
+            "src/generated/method_bind_hashes.h",
+            "src/generated/builtin_method_binds.hpp",
             "src/generated/variant_type_constants.hpp",
         ],
         [
             "tools/code_generation/generate_cpp_code.py",
             "src/luaopen/package_searcher.lua",
             "src/script-language/globals.lua",
+            "src/luaopen/ffi_views.lua",
+            "src/luaopen/ffi_math.lua",
             "lib/godot-cpp/gdextension/extension_api.json",
             "lib/godot-cpp/gen/include/godot_cpp/variant/utility_functions.hpp",
         ],